@@ -143,6 +143,14 @@ class V8_EXPORT Heap {
      */
     SweepingType sweeping_support = SweepingType::kIncrementalAndConcurrent;
 
+    /**
+     * Specifies whether threads other than the one creating the heap may
+     * allocate using `subtle::MutatorThreadScope`. Heaps that do not support
+     * attached threads avoid synchronization when resolving pointers to their
+     * pages, e.g., during conservative stack scanning.
+     */
+    bool supports_attached_threads = false;
+
     /**
      * Resource constraints specifying various properties that the internal
      * GC scheduler follows.
@@ -0,0 +1,102 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef INCLUDE_CPPGC_MUTATOR_THREAD_SCOPE_H_
+#define INCLUDE_CPPGC_MUTATOR_THREAD_SCOPE_H_
+
+#include <memory>
+
+#include "cppgc/macros.h"
+#include "v8config.h"  // NOLINT(build/include_directory)
+
+namespace cppgc {
+
+class AllocationHandle;
+class Heap;
+
+namespace internal {
+class Heap;
+class ObjectAllocator;
+}  // namespace internal
+
+namespace subtle {
+
+/**
+ * Attaches the current thread to a heap that was created on another thread
+ * for the lifetime of the scope. Attached threads allocate through their own
+ * linear allocation buffers using the handle returned by
+ * `GetAllocationHandle()`, i.e., without taking a global lock.
+ *
+ * Garbage collections are only triggered and performed by the thread that
+ * created the heap. Before a garbage collection, that thread waits until all
+ * attached threads are parked. A thread is parked while a `ParkedScope` is
+ * active and may park for a single point in time using `Safepoint()`. Attached
+ * threads should call `Safepoint()` periodically and park before blocking.
+ *
+ * Stacks of attached threads are not scanned. Parked threads must thus neither
+ * hold on-stack references to garbage-collected objects nor access the heap in
+ * any other way. References that outlive a safepoint must be held in
+ * `CrossThreadPersistent`. Objects with pre-finalizers must be allocated on the
+ * thread that created the heap.
+ *
+ * Attached threads are only supported for heaps that are created with
+ * `Heap::HeapOptions::supports_attached_threads`, use atomic marking
+ * (`Heap::MarkingType::kAtomic`), and have no young generation.
+ */
+class V8_EXPORT MutatorThreadScope final {
+  CPPGC_STACK_ALLOCATED();
+
+ public:
+  /**
+   * Parks the attached thread for the lifetime of the scope.
+   */
+  class V8_EXPORT V8_NODISCARD ParkedScope final {
+    CPPGC_STACK_ALLOCATED();
+
+   public:
+    explicit ParkedScope(MutatorThreadScope& scope);
+    ~ParkedScope();
+
+    ParkedScope(const ParkedScope&) = delete;
+    ParkedScope& operator=(const ParkedScope&) = delete;
+
+   private:
+    MutatorThreadScope& scope_;
+  };
+
+  /**
+   * Attaches the current thread to |heap|. Blocks while a garbage collection
+   * is in progress.
+   *
+   * \param heap The heap to attach to. Must outlive the scope.
+   */
+  explicit MutatorThreadScope(Heap* heap);
+  ~MutatorThreadScope();
+
+  MutatorThreadScope(const MutatorThreadScope&) = delete;
+  MutatorThreadScope& operator=(const MutatorThreadScope&) = delete;
+
+  /**
+   * \returns the handle that must be used for allocations on this thread.
+   */
+  AllocationHandle& GetAllocationHandle();
+
+  /**
+   * Parks the thread if a garbage collection is pending, and returns when it
+   * is done.
+   */
+  void Safepoint();
+
+ private:
+  void Park();
+  void Unpark();
+
+  internal::Heap* const heap_;
+  std::unique_ptr<internal::ObjectAllocator> allocator_;
+};
+
+}  // namespace subtle
+}  // namespace cppgc
+
+#endif  // INCLUDE_CPPGC_MUTATOR_THREAD_SCOPE_H_
@@ -7765,6 +7765,66 @@ using InterruptCallback = void (*)(Isolate* isolate, void* data);
 using NearHeapLimitCallback = size_t (*)(void* data, size_t current_heap_limit,
                                          size_t initial_heap_limit);
 
+/**
+ * This callback is invoked when an isolate is about to abort with an
+ * out-of-memory error because the HeapBudget that it shares with other
+ * isolates is exhausted. |used| is the sum of the heap sizes of all isolates
+ * that share the budget.
+ *
+ * The callback runs on the thread of |isolate| during one of its garbage
+ * collections. It must not call into |isolate|, and it must not dispose or
+ * enter other isolates from this thread. It can raise the budget by returning
+ * a value that is greater than current_budget. It can also ask other isolates
+ * to free memory using thread-safe methods such as
+ * Isolate::MemoryPressureNotification or Isolate::TerminateExecution, or have
+ * their own threads dispose them. Memory freed that way only becomes available
+ * once those isolates have completed a garbage collection, which is usually too
+ * late to prevent the out-of-memory error of |isolate|.
+ */
+using HeapBudgetExhaustedCallback = size_t (*)(void* data, Isolate* isolate,
+                                               size_t current_budget,
+                                               size_t used);
+
+/**
+ * A memory budget that is shared by all isolates that are created with it,
+ * see Isolate::CreateParams::heap_budget. The heaps of these isolates only
+ * grow into the part of the budget that the other isolates do not use. When
+ * the budget becomes tight, V8 asks the isolates with the largest heaps to
+ * reduce their memory first. The per-isolate ResourceConstraints still apply.
+ *
+ * All methods are thread-safe.
+ */
+class V8_EXPORT HeapBudget {
+ public:
+  /**
+   * Creates a budget of |budget_in_bytes| for the old generation heaps of
+   * all isolates that use it. The optional |callback| is invoked before an
+   * isolate aborts because the budget is exhausted.
+   */
+  static std::shared_ptr<HeapBudget> New(
+      size_t budget_in_bytes, HeapBudgetExhaustedCallback callback = nullptr,
+      void* data = nullptr);
+
+  virtual ~HeapBudget() = default;
+
+  /**
+   * Returns the budget in bytes.
+   */
+  virtual size_t Budget() const = 0;
+
+  /**
+   * Changes the budget. Isolates adjust their heap limits at their next
+   * garbage collection.
+   */
+  virtual void SetBudget(size_t budget_in_bytes) = 0;
+
+  /**
+   * Returns the sum of the heap sizes of all isolates that use the budget,
+   * as of their last full garbage collection.
+   */
+  virtual size_t Used() const = 0;
+};
+
 /**
  * Collection of shared per-process V8 memory information.
  *
@@ -8437,6 +8497,12 @@ class V8_EXPORT Isolate {
      */
     std::shared_ptr<CppHeapCreateParams> cpp_heap_params;
 
+    /**
+     * An optional memory budget that this isolate shares with other isolates.
+     * The isolate holds a reference to the budget until it is disposed.
+     */
+    std::shared_ptr<HeapBudget> heap_budget;
+
     /**
      * This list is provided by the embedder to indicate which import assertions
      * they want to handle. Only import assertions whose keys are present in
@@ -9431,6 +9497,16 @@ class V8_EXPORT Isolate {
    */
   void SetRAILMode(RAILMode rail_mode);
 
+  /**
+   * Optional notification to tell V8 the maximum duration, in milliseconds,
+   * that the embedder wants individual garbage collection steps and pauses
+   * to take. V8 uses the budget to size incremental marking steps and to
+   * schedule young generation collections before they grow too expensive.
+   * The budget is a soft target; atomic pauses may still exceed it.
+   * A budget of 0 (the default) restores V8's own heuristics.
+   */
+  void SetGarbageCollectionPauseBudget(double milliseconds);
+
   /**
    * Optional notification to tell V8 the current isolate is used for debugging
    * and requires higher heap limit.
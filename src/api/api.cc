@@ -53,6 +53,7 @@
 #include "src/handles/global-handles.h"
 #include "src/handles/persistent-handles.h"
 #include "src/heap/embedder-tracing.h"
+#include "src/heap/heap-budget.h"
 #include "src/heap/heap-inl.h"
 #include "src/init/bootstrapper.h"
 #include "src/init/icu_util.h"
@@ -8515,6 +8516,12 @@ Isolate* Isolate::Allocate() {
   return reinterpret_cast<Isolate*>(i::Isolate::New());
 }
 
+// static
+std::shared_ptr<HeapBudget> HeapBudget::New(
+    size_t budget_in_bytes, HeapBudgetExhaustedCallback callback, void* data) {
+  return std::make_shared<i::HeapBudget>(budget_in_bytes, callback, data);
+}
+
 Isolate::CreateParams::CreateParams() = default;
 
 Isolate::CreateParams::~CreateParams() = default;
@@ -8572,6 +8579,9 @@ void Isolate::Initialize(Isolate* isolate,
   if (params.cpp_heap_params) {
     i_isolate->heap()->ConfigureCppHeap(params.cpp_heap_params);
   }
+  if (params.heap_budget) {
+    i_isolate->heap()->ConfigureHeapBudget(params.heap_budget);
+  }
   if (params.constraints.stack_limit() != nullptr) {
     uintptr_t limit =
         reinterpret_cast<uintptr_t>(params.constraints.stack_limit());
@@ -9159,6 +9169,14 @@ void Isolate::SetRAILMode(RAILMode rail_mode) {
   return isolate->SetRAILMode(rail_mode);
 }
 
+void Isolate::SetGarbageCollectionPauseBudget(double milliseconds) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  Utils::ApiCheck(milliseconds >= 0,
+                  "v8::Isolate::SetGarbageCollectionPauseBudget",
+                  "Budget must be non-negative");
+  isolate->heap()->SetGarbageCollectionPauseBudget(milliseconds);
+}
+
 void Isolate::IncreaseHeapLimitForDebugging() {
   // No-op.
 }
@@ -205,6 +205,18 @@ bool OS::HasLazyCommits() {
   return false;
 }
 
+// static
+bool OS::MakePagesMergeable(void* address, size_t size) {
+  // Page deduplication is not available on this platform.
+  return false;
+}
+
+// static
+bool OS::AdviseHugePages(void* address, size_t size) {
+  // Transparent huge pages are not available on this platform.
+  return false;
+}
+
 std::vector<OS::SharedLibraryAddress> OS::GetSharedLibraryAddresses() {
   std::vector<SharedLibraryAddresses> result;
   // This function assumes that the layout of the file is as follows:
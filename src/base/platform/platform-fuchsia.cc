@@ -137,6 +137,18 @@ bool OS::HasLazyCommits() {
   return false;
 }
 
+// static
+bool OS::MakePagesMergeable(void* address, size_t size) {
+  // Page deduplication is not available on this platform.
+  return false;
+}
+
+// static
+bool OS::AdviseHugePages(void* address, size_t size) {
+  // Transparent huge pages are not available on this platform.
+  return false;
+}
+
 std::vector<OS::SharedLibraryAddress> OS::GetSharedLibraryAddresses() {
   UNREACHABLE();  // TODO(scottmg): Port, https://crbug.com/731217.
 }
@@ -471,6 +471,28 @@ bool OS::HasLazyCommits() {
   return false;
 #endif
 }
+
+// static
+bool OS::MakePagesMergeable(void* address, size_t size) {
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+  DCHECK_EQ(0, size % CommitPageSize());
+#if V8_OS_LINUX && defined(MADV_MERGEABLE)
+  return madvise(address, size, MADV_MERGEABLE) == 0;
+#else
+  return false;
+#endif
+}
+
+// static
+bool OS::AdviseHugePages(void* address, size_t size) {
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+  DCHECK_EQ(0, size % CommitPageSize());
+#if V8_OS_LINUX && defined(MADV_HUGEPAGE)
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
 #endif  // !V8_OS_CYGWIN && !V8_OS_FUCHSIA
 
 const char* OS::GetGCFakeMMapFile() {
@@ -257,6 +257,18 @@ bool OS::HasLazyCommits() {
   return false;
 }
 
+// static
+bool OS::MakePagesMergeable(void* address, size_t size) {
+  // Page deduplication is not available on this platform.
+  return false;
+}
+
+// static
+bool OS::AdviseHugePages(void* address, size_t size) {
+  // Transparent huge pages are not available on this platform.
+  return false;
+}
+
 void OS::Sleep(TimeDelta interval) { SbThreadSleep(interval.InMicroseconds()); }
 
 void OS::Abort() { SbSystemBreakIntoDebugger(); }
@@ -181,6 +181,16 @@ class V8_BASE_EXPORT OS {
 
   static bool HasLazyCommits();
 
+  // Hints to the OS that the given committed, page-aligned range may be
+  // deduplicated with identical pages of other processes (e.g. KSM on Linux).
+  // Returns false if the hint is not supported or was rejected.
+  static bool MakePagesMergeable(void* address, size_t size);
+
+  // Hints to the OS that the given committed, page-aligned range should be
+  // backed by transparent huge pages (e.g. MADV_HUGEPAGE on Linux). Returns
+  // false if the hint is not supported or was rejected.
+  static bool AdviseHugePages(void* address, size_t size);
+
   // Sleep for a specified time interval.
   static void Sleep(TimeDelta interval);
 
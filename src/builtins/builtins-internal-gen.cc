@@ -283,26 +283,24 @@ class RecordWriteCodeStubAssembler : public CodeStubAssembler {
   }
 
   void SetBitInCell(TNode<IntPtrT> bucket, TNode<WordT> slot_offset) {
-    // Load cell value
+    // Calculate cell offset
     TNode<WordT> cell_offset = WordAnd(
         WordShr(slot_offset, SlotSet::kBitsPerCellLog2 + kTaggedSizeLog2 -
                                  SlotSet::kCellSizeBytesLog2),
         IntPtrConstant((SlotSet::kCellsPerBucket - 1)
                        << SlotSet::kCellSizeBytesLog2));
-    TNode<IntPtrT> cell_address =
-        UncheckedCast<IntPtrT>(IntPtrAdd(bucket, cell_offset));
-    TNode<IntPtrT> old_cell_value =
-        ChangeInt32ToIntPtr(Load<Int32T>(cell_address));
 
-    // Calculate new cell value
+    // Calculate bit mask
     TNode<WordT> bit_index = WordAnd(WordShr(slot_offset, kTaggedSizeLog2),
                                      IntPtrConstant(SlotSet::kBitsPerCell - 1));
-    TNode<IntPtrT> new_cell_value = UncheckedCast<IntPtrT>(
-        WordOr(old_cell_value, WordShl(IntPtrConstant(1), bit_index)));
-
-    // Update cell value
-    StoreNoWriteBarrier(MachineRepresentation::kWord32, cell_address,
-                        TruncateIntPtrToInt32(new_cell_value));
+    TNode<Word32T> bit_mask = TruncateIntPtrToInt32(
+        UncheckedCast<IntPtrT>(WordShl(IntPtrConstant(1), bit_index)));
+
+    // Update cell value. Background threads recording old-to-new slots and the
+    // concurrent remembered set filter modify the same cells, so a plain
+    // load and store could drop their bits.
+    AtomicOr(MachineType::Uint32(), ReinterpretCast<RawPtrT>(bucket),
+             Unsigned(cell_offset), bit_mask);
   }
 };
 
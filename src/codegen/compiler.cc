@@ -1933,6 +1933,9 @@ bool Compiler::CompileOptimized(Handle<JSFunction> function,
 
   if (!IsForNativeContextIndependentCachingOnly(code_kind)) {
     function->set_code(*code);
+    if (CodeKindIsOptimizedAndCanTierUp(code->kind())) {
+      function->raw_feedback_cell().SetInterruptBudgetForMidtier();
+    }
   }
 
   // Check postconditions on success.
@@ -3081,6 +3084,13 @@ bool Compiler::FinalizeOptimizedCompilationJob(OptimizedCompilationJob* job,
       CompilerTracer::TraceCompletedJob(isolate, compilation_info);
       if (should_install_code_on_function) {
         compilation_info->closure()->set_code(*compilation_info->code());
+        // Start counting towards the next tier with a full budget, since the
+        // remainder of the interpreter's budget is much smaller.
+        if (CodeKindIsOptimizedAndCanTierUp(code_kind)) {
+          compilation_info->closure()
+              ->raw_feedback_cell()
+              .SetInterruptBudgetForMidtier();
+        }
       }
       return CompilationJob::SUCCEEDED;
     }
@@ -0,0 +1,352 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/bounds-check-elimination.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "src/compiler/all-nodes.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/compiler/type-cache.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                                      \
+  do {                                                                  \
+    if (FLAG_trace_turbo_bounds_check_elimination) PrintF(__VA_ARGS__); \
+  } while (false)
+
+namespace {
+
+// Limits on how far the analysis looks for dominating conditions and for
+// checks to merge, which keeps compile time linear in the number of checks.
+const int kMaxControlDistance = 64;
+const int kMaxMergeDistance = 16;
+// Offsets beyond this are unlikely to belong to the same loop body.
+const double kMaxOffset = 1 << 16;
+
+// Returns the only effect use of {node}, or nullptr.
+Node* FindEffectUse(Node* node) {
+  Node* result = nullptr;
+  for (Edge edge : node->use_edges()) {
+    if (!NodeProperties::IsEffectEdge(edge)) continue;
+    if (result != nullptr) return nullptr;
+    result = edge.from();
+  }
+  return result;
+}
+
+// Returns true if deoptimizing in front of {node} instead of behind it is not
+// observable, which is the case if {node} does not write to memory or call out
+// of the function.
+bool CanDeoptimizeAcross(Node* node) {
+  if (node->op()->EffectInputCount() != 1 ||
+      node->op()->EffectOutputCount() != 1) {
+    return false;
+  }
+  switch (node->opcode()) {
+    case IrOpcode::kCheckpoint:
+      return true;
+    case IrOpcode::kBeginRegion:
+    case IrOpcode::kFinishRegion:
+      return false;
+    default:
+      // Checks and speculative operations are foldable and only deoptimize.
+      return node->op()->HasProperty(Operator::kNoWrite) ||
+             node->op()->HasProperty(Operator::kFoldable);
+  }
+}
+
+}  // namespace
+
+// A CheckBounds node whose index is {base + offset}.
+struct BoundsCheckElimination::Candidate {
+  Node* check;
+  Node* base;
+  Node* length;
+  int32_t offset;
+};
+
+BoundsCheckElimination::BoundsCheckElimination(JSGraph* jsgraph, Zone* zone)
+    : jsgraph_(jsgraph), zone_(zone), type_cache_(TypeCache::Get()) {}
+
+Graph* BoundsCheckElimination::graph() const { return jsgraph()->graph(); }
+
+CommonOperatorBuilder* BoundsCheckElimination::common() const {
+  return jsgraph()->common();
+}
+
+SimplifiedOperatorBuilder* BoundsCheckElimination::simplified() const {
+  return jsgraph()->simplified();
+}
+
+void BoundsCheckElimination::Run() {
+  AllNodes all(zone(), graph());
+  ZoneVector<Node*> checks(zone());
+  for (Node* node : all.reachable) {
+    if (node->opcode() == IrOpcode::kCheckBounds) checks.push_back(node);
+  }
+
+  for (Node* check : checks) {
+    if (!IsProvenInBounds(check)) continue;
+    TRACE("Eliminating bounds check #%d\n", check->id());
+    Eliminate(check);
+    eliminated_checks_++;
+  }
+
+  ZoneSet<Node*> visited(zone());
+  for (Node* check : checks) {
+    if (check->opcode() != IrOpcode::kCheckBounds) continue;
+    if (visited.count(check)) continue;
+    MergeChecks(check, &visited);
+  }
+}
+
+bool BoundsCheckElimination::MatchCandidate(Node* check,
+                                            Candidate* candidate) const {
+  DCHECK_EQ(IrOpcode::kCheckBounds, check->opcode());
+  // Checks that abort are already known to be in bounds.
+  if (CheckBoundsParametersOf(check->op()).flags() &
+      CheckBoundsFlag::kAbortOnOutOfBounds) {
+    return false;
+  }
+  Node* index = NodeProperties::GetValueInput(check, 0);
+  Node* length = NodeProperties::GetValueInput(check, 1);
+  if (!NodeProperties::IsTyped(index) || !NodeProperties::IsTyped(length)) {
+    return false;
+  }
+  // Safe integer indices are neither strings nor minus zero, so the check
+  // does not need to convert them. Lengths of typed arrays may exceed the
+  // Unsigned31 range of JS array lengths on 64-bit platforms.
+  Type const index_type = NodeProperties::GetType(index);
+  Type const length_type = NodeProperties::GetType(length);
+  if (index_type.IsNone() || !index_type.Is(type_cache_->kSafeInteger) ||
+      length_type.IsNone() ||
+      !length_type.Is(type_cache_->kPositiveSafeInteger)) {
+    return false;
+  }
+
+  candidate->check = check;
+  candidate->base = index;
+  candidate->length = length;
+  candidate->offset = 0;
+
+  double sign;
+  switch (index->opcode()) {
+    case IrOpcode::kNumberAdd:
+    case IrOpcode::kSpeculativeNumberAdd:
+    case IrOpcode::kSpeculativeSafeIntegerAdd:
+      sign = 1;
+      break;
+    case IrOpcode::kNumberSubtract:
+    case IrOpcode::kSpeculativeNumberSubtract:
+    case IrOpcode::kSpeculativeSafeIntegerSubtract:
+      sign = -1;
+      break;
+    default:
+      return true;
+  }
+  Node* base = NodeProperties::GetValueInput(index, 0);
+  NumberMatcher m(NodeProperties::GetValueInput(index, 1));
+  if (!NodeProperties::IsTyped(base) ||
+      !NodeProperties::GetType(base).Is(type_cache_->kSafeInteger) ||
+      NodeProperties::GetType(base).IsNone() || !m.HasResolvedValue() ||
+      !m.IsInteger() || std::abs(m.ResolvedValue()) > kMaxOffset) {
+    return true;
+  }
+  candidate->base = base;
+  candidate->offset = static_cast<int32_t>(sign * m.ResolvedValue());
+  return true;
+}
+
+bool BoundsCheckElimination::ProvesUpperBound(Node* condition, bool polarity,
+                                              const Candidate& candidate) {
+  bool strict;
+  switch (condition->opcode()) {
+    case IrOpcode::kNumberLessThan:
+    case IrOpcode::kSpeculativeNumberLessThan:
+      strict = true;
+      break;
+    case IrOpcode::kNumberLessThanOrEqual:
+    case IrOpcode::kSpeculativeNumberLessThanOrEqual:
+      strict = false;
+      break;
+    default:
+      return false;
+  }
+  Node* lhs = NodeProperties::GetValueInput(condition, 0);
+  Node* rhs = NodeProperties::GetValueInput(condition, 1);
+  // Neither the base nor the length can be NaN, so {length < base} being
+  // false implies {base <= length}.
+  if (!polarity) {
+    std::swap(lhs, rhs);
+    strict = !strict;
+  }
+  if (lhs != candidate.base || rhs != candidate.length) return false;
+  return candidate.offset <= (strict ? 0 : -1);
+}
+
+bool BoundsCheckElimination::IsProvenInBounds(Node* check) {
+  Candidate candidate;
+  if (!MatchCandidate(check, &candidate)) return false;
+  Node* index = NodeProperties::GetValueInput(check, 0);
+  Type const index_type = NodeProperties::GetType(index);
+  Type const length_type = NodeProperties::GetType(candidate.length);
+  if (index_type.Min() < 0) return false;
+  if (index_type.Max() < length_type.Min()) return true;
+
+  // Look for a condition {base < length} or {base <= length} that dominates
+  // the check. Values never change, so conditions stay valid across calls
+  // and loop headers; a length that may have changed is a different node.
+  Node* control = NodeProperties::GetControlInput(check);
+  for (int i = 0; i < kMaxControlDistance; ++i) {
+    switch (control->opcode()) {
+      case IrOpcode::kIfTrue:
+      case IrOpcode::kIfFalse: {
+        Node* branch = NodeProperties::GetControlInput(control);
+        if (ProvesUpperBound(NodeProperties::GetValueInput(branch, 0),
+                             control->opcode() == IrOpcode::kIfTrue,
+                             candidate)) {
+          return true;
+        }
+        control = NodeProperties::GetControlInput(branch);
+        break;
+      }
+      case IrOpcode::kLoop:
+        control = NodeProperties::GetControlInput(control, 0);
+        break;
+      default:
+        if (control->op()->ControlInputCount() != 1) return false;
+        control = NodeProperties::GetControlInput(control);
+        break;
+    }
+  }
+  return false;
+}
+
+void BoundsCheckElimination::MergeChecks(Node* check, ZoneSet<Node*>* visited) {
+  Candidate first;
+  if (!MatchCandidate(check, &first)) return;
+  Node* const control = NodeProperties::GetControlInput(check);
+
+  // Only start a group at its first check, which is found by walking the
+  // effect chain backwards the same way it is walked forwards below.
+  Node* current = check;
+  for (int i = 0; i < kMaxMergeDistance; ++i) {
+    Node* previous = NodeProperties::GetEffectInput(current);
+    if (previous->op()->ControlInputCount() != 1 ||
+        NodeProperties::GetControlInput(previous) != control ||
+        !CanDeoptimizeAcross(previous)) {
+      break;
+    }
+    Candidate candidate;
+    if (previous->opcode() == IrOpcode::kCheckBounds &&
+        MatchCandidate(previous, &candidate) && candidate.base == first.base &&
+        candidate.length == first.length) {
+      return;
+    }
+    current = previous;
+  }
+
+  // Collect the checks of {base + offset} against the same length that
+  // follow on the effect chain. They are executed whenever {check} is, since
+  // they share its control.
+  ZoneVector<Candidate> group(zone());
+  group.push_back(first);
+  current = check;
+  for (int i = 0; i < kMaxMergeDistance; ++i) {
+    Node* next = FindEffectUse(current);
+    if (next == nullptr || next->opcode() == IrOpcode::kEffectPhi ||
+        next->op()->ControlInputCount() != 1 ||
+        NodeProperties::GetControlInput(next) != control) {
+      break;
+    }
+    Candidate candidate;
+    if (next->opcode() == IrOpcode::kCheckBounds &&
+        MatchCandidate(next, &candidate) && candidate.base == first.base &&
+        candidate.length == first.length) {
+      group.push_back(candidate);
+      visited->insert(next);
+    } else if (!CanDeoptimizeAcross(next)) {
+      break;
+    }
+    current = next;
+  }
+  if (group.size() < 2) return;
+
+  int32_t min_offset = first.offset;
+  int32_t max_offset = first.offset;
+  bool lower_bound_known = true;
+  for (const Candidate& candidate : group) {
+    min_offset = std::min(min_offset, candidate.offset);
+    max_offset = std::max(max_offset, candidate.offset);
+    Node* index = NodeProperties::GetValueInput(candidate.check, 0);
+    if (NodeProperties::GetType(index).Min() < 0) lower_bound_known = false;
+  }
+  // Checking {base + min_offset} and {base + max_offset} covers all offsets
+  // in between. The lower one is not needed if no index can be negative.
+  size_t const new_checks = lower_bound_known ? 1 : 2;
+  if (group.size() <= new_checks) return;
+  // The widened indices have to stay safe integers, so that adding the
+  // offsets is exact and the checks need no conversion either.
+  Type const base_type = NodeProperties::GetType(first.base);
+  if (base_type.Min() + min_offset < -kMaxSafeInteger ||
+      base_type.Max() + max_offset > kMaxSafeInteger) {
+    return;
+  }
+
+  // The widened checks deoptimize in place of {check}. Nothing observable
+  // happens between {check} and the last check of the group, so this only
+  // moves deoptimizations that would have happened anyway.
+  CheckBoundsParameters const& p = CheckBoundsParametersOf(check->op());
+  const Operator* op = simplified()->CheckBounds(
+      p.check_parameters().feedback(),
+      p.flags().without(CheckBoundsFlag::kConvertStringAndMinusZero));
+  Node* effect = NodeProperties::GetEffectInput(check);
+  if (!lower_bound_known) {
+    effect = graph()->NewNode(op, IndexWithOffset(first.base, min_offset),
+                              first.length, effect, control);
+  }
+  effect = graph()->NewNode(op, IndexWithOffset(first.base, max_offset),
+                            first.length, effect, control);
+  NodeProperties::ReplaceEffectInput(check, effect);
+  TRACE("Merging %zu bounds checks into #%d\n", group.size(), effect->id());
+  for (const Candidate& candidate : group) Eliminate(candidate.check);
+  merged_checks_ += group.size() - new_checks;
+}
+
+Node* BoundsCheckElimination::IndexWithOffset(Node* base, int32_t offset) {
+  if (offset == 0) return base;
+  return graph()->NewNode(simplified()->NumberAdd(), base,
+                          jsgraph()->Constant(offset));
+}
+
+void BoundsCheckElimination::Eliminate(Node* check) {
+  // Keep the type of the check by turning it into a TypeGuard, which stays
+  // in the same place of the effect and control chains.
+  Type const type = NodeProperties::GetType(check);
+  Node* index = NodeProperties::GetValueInput(check, 0);
+  Node* effect = NodeProperties::GetEffectInput(check);
+  Node* control = NodeProperties::GetControlInput(check);
+  check->TrimInputCount(0);
+  check->AppendInput(graph()->zone(), index);
+  check->AppendInput(graph()->zone(), effect);
+  check->AppendInput(graph()->zone(), control);
+  NodeProperties::ChangeOp(check, common()->TypeGuard(type));
+}
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
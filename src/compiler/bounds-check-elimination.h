@@ -0,0 +1,81 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
+#define V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
+
+#include "src/base/compiler-specific.h"
+#include "src/common/globals.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class CommonOperatorBuilder;
+class Graph;
+class JSGraph;
+class Node;
+class SimplifiedOperatorBuilder;
+class TypeCache;
+
+// Removes CheckBounds nodes whose index is known to be in bounds, and merges
+// checks of {base + constant} against the same length into one widened check.
+//
+// The lower bound of an index is taken from its type, which for induction
+// variables is computed by the typer from the LoopVariableOptimizer's bounds.
+// The upper bound is taken from the branch conditions that dominate the
+// check, i.e. for loops like
+//
+//   for (let i = 0; i < a.length; i++) a[i]
+//
+// the condition {i < a.length} proves {a[i]} to be in bounds once load
+// elimination has made both refer to the same length. This covers JS arrays
+// and typed arrays alike, since both use CheckBounds against a length.
+//
+// This has to run while the graph is still typed, since new nodes are typed
+// by the typer's decorator.
+class V8_EXPORT_PRIVATE BoundsCheckElimination final {
+ public:
+  BoundsCheckElimination(JSGraph* jsgraph, Zone* zone);
+
+  void Run();
+
+  // Number of CheckBounds nodes that were proven to be redundant.
+  size_t eliminated_checks() const { return eliminated_checks_; }
+  // Number of CheckBounds nodes that were removed by merging them into a
+  // widened check.
+  size_t merged_checks() const { return merged_checks_; }
+
+ private:
+  struct Candidate;
+
+  bool IsProvenInBounds(Node* check);
+  // Returns true if {condition} being {polarity} implies that the index of
+  // {candidate} is below its length.
+  static bool ProvesUpperBound(Node* condition, bool polarity,
+                               const Candidate& candidate);
+  void MergeChecks(Node* check, ZoneSet<Node*>* visited);
+  bool MatchCandidate(Node* check, Candidate* candidate) const;
+  Node* IndexWithOffset(Node* base, int32_t offset);
+  void Eliminate(Node* check);
+
+  Graph* graph() const;
+  CommonOperatorBuilder* common() const;
+  SimplifiedOperatorBuilder* simplified() const;
+  JSGraph* jsgraph() const { return jsgraph_; }
+  Zone* zone() const { return zone_; }
+
+  JSGraph* const jsgraph_;
+  Zone* const zone_;
+  TypeCache const* const type_cache_;
+  size_t eliminated_checks_ = 0;
+  size_t merged_checks_ = 0;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
@@ -0,0 +1,349 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-invariant-code-motion.h"
+
+#include "src/base/small-vector.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/objects/heap-object.h"
+#include "src/objects/js-objects.h"
+#include "src/zone/zone.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_loop) PrintF(__VA_ARGS__); \
+  } while (false)
+
+namespace {
+
+// Checks whose outcome only depends on their value inputs. Objects never
+// change between being strings, symbols, numbers or receivers.
+bool IsValueCheck(Node* node) {
+  switch (node->opcode()) {
+#define CASE(Name) case IrOpcode::k##Name:
+    SIMPLIFIED_CHECKED_OP_LIST(CASE)
+    SIMPLIFIED_SPECULATIVE_NUMBER_BINOP_LIST(CASE)
+    SIMPLIFIED_SPECULATIVE_NUMBER_UNOP_LIST(CASE)
+#undef CASE
+    case IrOpcode::kSpeculativeNumberEqual:
+    case IrOpcode::kSpeculativeNumberLessThan:
+    case IrOpcode::kSpeculativeNumberLessThanOrEqual:
+    case IrOpcode::kCheckBounds:
+    case IrOpcode::kCheckEqualsInternalizedString:
+    case IrOpcode::kCheckEqualsSymbol:
+    case IrOpcode::kCheckFloat64Hole:
+    case IrOpcode::kCheckHeapObject:
+    case IrOpcode::kCheckIf:
+    case IrOpcode::kCheckNotTaggedHole:
+    case IrOpcode::kCheckNumber:
+    case IrOpcode::kCheckReceiver:
+    case IrOpcode::kCheckReceiverOrNullOrUndefined:
+    case IrOpcode::kCheckSmi:
+    case IrOpcode::kCheckString:
+    case IrOpcode::kCheckSymbol:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Checks whose outcome depends on the map of their input.
+bool IsMapCheck(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kCheckMaps:
+    case IrOpcode::kCheckInternalizedString:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsFreshAllocation(Node* node) {
+  return node->opcode() == IrOpcode::kAllocate ||
+         node->opcode() == IrOpcode::kAllocateRaw;
+}
+
+// Returns the only effect use of {node}, ignoring the Terminate node that
+// keeps a loop alive.
+Node* FindEffectUse(Node* node) {
+  Node* result = nullptr;
+  for (Edge edge : node->use_edges()) {
+    if (!NodeProperties::IsEffectEdge(edge)) continue;
+    if (edge.from()->opcode() == IrOpcode::kTerminate) continue;
+    if (result != nullptr) return nullptr;
+    result = edge.from();
+  }
+  return result;
+}
+
+}  // namespace
+
+// Summarizes the memory that may be written by any iteration of a loop. Same
+// as for load elimination, the effect chains are walked backwards from the
+// back edges of the loop header's EffectPhi.
+class LoopInvariantCodeMotion::LoopEffects final {
+ public:
+  LoopEffects(LoopTree* loop_tree, LoopTree::Loop* loop, Node* effect_phi,
+              Zone* zone)
+      : loop_tree_(loop_tree), loop_(loop), killed_fields_(zone) {
+    ZoneQueue<Node*> queue(zone);
+    ZoneSet<Node*> visited(zone);
+    visited.insert(effect_phi);
+    for (int i = 1; i < effect_phi->op()->EffectInputCount(); ++i) {
+      queue.push(NodeProperties::GetEffectInput(effect_phi, i));
+    }
+    while (!queue.empty() && !kills_all_) {
+      Node* const current = queue.front();
+      queue.pop();
+      if (!visited.insert(current).second) continue;
+      Visit(current);
+      for (int i = 0; i < current->op()->EffectInputCount(); ++i) {
+        queue.push(NodeProperties::GetEffectInput(current, i));
+      }
+    }
+  }
+
+  bool KillsField(int offset) const {
+    return kills_all_ || killed_fields_.count(offset) != 0;
+  }
+  bool KillsElements() const { return kills_all_ || kills_elements_; }
+
+ private:
+  void Visit(Node* node) {
+    if (node->op()->HasProperty(Operator::kNoWrite)) return;
+    // Checks either deoptimize or produce a value.
+    if (IsValueCheck(node) || IsMapCheck(node)) return;
+    switch (node->opcode()) {
+      case IrOpcode::kAllocate:
+      case IrOpcode::kAllocateRaw:
+      case IrOpcode::kBeginRegion:
+      case IrOpcode::kCheckpoint:
+      case IrOpcode::kEffectPhi:
+      case IrOpcode::kFinishRegion:
+      case IrOpcode::kTypeGuard:
+        break;
+      case IrOpcode::kStoreField: {
+        Node* const object = NodeProperties::GetValueInput(node, 0);
+        if (IsAllocatedInLoop(object)) break;
+        killed_fields_.insert(FieldAccessOf(node->op()).offset);
+        break;
+      }
+      case IrOpcode::kStoreElement: {
+        Node* const object = NodeProperties::GetValueInput(node, 0);
+        if (IsAllocatedInLoop(object)) break;
+        kills_elements_ = true;
+        break;
+      }
+      case IrOpcode::kStoreTypedElement:
+        kills_elements_ = true;
+        break;
+      case IrOpcode::kEnsureWritableFastElements:
+      case IrOpcode::kMaybeGrowFastElements:
+        killed_fields_.insert(JSObject::kElementsOffset);
+        kills_elements_ = true;
+        break;
+      case IrOpcode::kTransitionElementsKind:
+      case IrOpcode::kTransitionAndStoreElement:
+        killed_fields_.insert(HeapObject::kMapOffset);
+        killed_fields_.insert(JSObject::kElementsOffset);
+        kills_elements_ = true;
+        break;
+      default:
+        kills_all_ = true;
+        break;
+    }
+  }
+
+  // Objects allocated inside of the loop are fresh in every iteration and
+  // cannot be loop invariant. Objects allocated before the loop can be.
+  bool IsAllocatedInLoop(Node* object) const {
+    return IsFreshAllocation(object) && loop_tree_->Contains(loop_, object);
+  }
+
+  LoopTree* const loop_tree_;
+  LoopTree::Loop* const loop_;
+  ZoneSet<int> killed_fields_;
+  bool kills_elements_ = false;
+  bool kills_all_ = false;
+};
+
+void LoopInvariantCodeMotion::Optimize() {
+  for (LoopTree::Loop* loop : loop_tree_->outer_loops()) {
+    OptimizeLoops(loop);
+  }
+}
+
+void LoopInvariantCodeMotion::OptimizeLoops(LoopTree::Loop* loop) {
+  for (LoopTree::Loop* inner_loop : loop->children()) {
+    OptimizeLoops(inner_loop);
+  }
+  OptimizeLoop(loop);
+}
+
+bool LoopInvariantCodeMotion::IsInvariant(
+    LoopTree::Loop* loop, Node* node, const ZoneSet<Node*>& hoisted) const {
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    Node* const input = NodeProperties::GetValueInput(node, i);
+    if (loop_tree_->Contains(loop, input) && hoisted.count(input) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoopInvariantCodeMotion::CanHoist(LoopTree::Loop* loop, Node* node,
+                                       const LoopEffects& effects,
+                                       const ZoneSet<Node*>& hoisted) const {
+  if (IsValueCheck(node)) return IsInvariant(loop, node, hoisted);
+  switch (node->opcode()) {
+    case IrOpcode::kCheckMaps:
+    case IrOpcode::kCheckInternalizedString:
+      return !effects.KillsField(HeapObject::kMapOffset) &&
+             IsInvariant(loop, node, hoisted);
+    case IrOpcode::kLoadField:
+      return !effects.KillsField(FieldAccessOf(node->op()).offset) &&
+             IsInvariant(loop, node, hoisted);
+    case IrOpcode::kLoadElement:
+      return !effects.KillsElements() && IsInvariant(loop, node, hoisted);
+    default:
+      return false;
+  }
+}
+
+Node* LoopInvariantCodeMotion::CopyFrameStateForEntry(
+    LoopTree::Loop* loop, Node* loop_node, Node* state,
+    ZoneMap<Node*, Node*>* copies) {
+  if (!loop_tree_->Contains(loop, state)) return state;
+  auto it = copies->find(state);
+  if (it != copies->end()) return it->second;
+
+  Node* copy = nullptr;
+  switch (state->opcode()) {
+    case IrOpcode::kPhi:
+      if (NodeProperties::GetControlInput(state) == loop_node) {
+        copy = state->InputAt(kAssumedLoopEntryIndex);
+      }
+      break;
+    case IrOpcode::kFrameState:
+    case IrOpcode::kStateValues:
+    case IrOpcode::kTypedStateValues: {
+      base::SmallVector<Node*, 16> inputs;
+      bool changed = false;
+      for (Node* const input : state->inputs()) {
+        Node* const input_copy =
+            CopyFrameStateForEntry(loop, loop_node, input, copies);
+        if (input_copy == nullptr) {
+          inputs.clear();
+          break;
+        }
+        changed |= input_copy != input;
+        inputs.push_back(input_copy);
+      }
+      if (inputs.size() != static_cast<size_t>(state->InputCount())) break;
+      if (!changed) {
+        copy = state;
+        break;
+      }
+      copy = graph()->CloneNode(state);
+      for (int i = 0; i < copy->InputCount(); ++i) {
+        copy->ReplaceInput(i, inputs[i]);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  copies->insert(std::make_pair(state, copy));
+  return copy;
+}
+
+size_t LoopInvariantCodeMotion::OptimizeLoop(LoopTree::Loop* loop) {
+  Node* const loop_node = loop_tree_->GetLoopControl(loop);
+  Node* effect_phi = nullptr;
+  for (Node* use : loop_node->uses()) {
+    if (use->opcode() == IrOpcode::kEffectPhi) {
+      effect_phi = use;
+      break;
+    }
+  }
+  if (effect_phi == nullptr) return 0;
+
+  LoopEffects effects(loop_tree_, loop, effect_phi, tmp_zone_);
+  ZoneSet<Node*> hoisted(tmp_zone_);
+  ZoneMap<Node*, Node*> copies(tmp_zone_);
+  Node* const entry_control = loop_node->InputAt(kAssumedLoopEntryIndex);
+  Node* entry_effect = effect_phi->InputAt(kAssumedLoopEntryIndex);
+  // The last checkpoint on the header's effect chain, and the one whose frame
+  // state was last copied in front of the loop.
+  Node* checkpoint = nullptr;
+  Node* entry_checkpoint_origin = nullptr;
+
+  // Only nodes that are controlled by the loop header itself are visited, as
+  // they are executed on every iteration before the loop can be left.
+  Node* effect = effect_phi;
+  while (Node* const node = FindEffectUse(effect)) {
+    if (node->op()->ControlInputCount() != 1 ||
+        NodeProperties::GetControlInput(node) != loop_node) {
+      break;
+    }
+    if (node->opcode() == IrOpcode::kCheckpoint) {
+      checkpoint = node;
+      effect = node;
+      continue;
+    }
+
+    bool const can_deopt = !node->op()->HasProperty(Operator::kNoDeopt);
+    if (CanHoist(loop, node, effects, hoisted) &&
+        (!can_deopt || checkpoint != nullptr)) {
+      if (can_deopt && checkpoint != entry_checkpoint_origin) {
+        Node* const frame_state = CopyFrameStateForEntry(
+            loop, loop_node, NodeProperties::GetFrameStateInput(checkpoint),
+            &copies);
+        if (frame_state == nullptr) break;
+        entry_effect = graph()->NewNode(common()->Checkpoint(), frame_state,
+                                        entry_effect, entry_control);
+        entry_checkpoint_origin = checkpoint;
+      }
+      DCHECK_EQ(0, node->op()->ControlOutputCount());
+      DCHECK_EQ(effect, NodeProperties::GetEffectInput(node));
+      for (Edge edge : node->use_edges()) {
+        if (NodeProperties::IsEffectEdge(edge)) edge.UpdateTo(effect);
+      }
+      NodeProperties::ReplaceEffectInput(node, entry_effect);
+      NodeProperties::ReplaceControlInput(node, entry_control);
+      entry_effect = node;
+      hoisted.insert(node);
+      TRACE("Hoisted #%d:%s out of loop #%d\n", node->id(),
+            node->op()->mnemonic(), loop_node->id());
+      continue;
+    }
+
+    // Skipping over reads is fine as the hoisted nodes do not write.
+    if (node->op()->HasProperty(Operator::kNoWrite) &&
+        node->op()->HasProperty(Operator::kNoDeopt)) {
+      effect = node;
+      continue;
+    }
+    break;
+  }
+
+  if (!hoisted.empty()) {
+    effect_phi->ReplaceInput(kAssumedLoopEntryIndex, entry_effect);
+  }
+  return hoisted.size();
+}
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
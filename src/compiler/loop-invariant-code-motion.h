@@ -0,0 +1,75 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+#define V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+
+#include "src/base/compiler-specific.h"
+#include "src/common/globals.h"
+#include "src/compiler/loop-analysis.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class CommonOperatorBuilder;
+class Graph;
+class Node;
+
+// Hoists loop-invariant checks and loads out of loops. Candidates are taken
+// from the effect chain of the loop header, i.e. from the part of the loop
+// that is executed on every iteration before the first loop exit, so that
+// hoisting never introduces a deoptimization that the original code would
+// not have hit on its first iteration. A candidate is hoisted if all of its
+// value inputs are defined outside of the loop and no store inside of the loop
+// can change the memory it depends on. Hoisted checks deoptimize to the
+// frame state of the header's checkpoint, rewritten to use the values that
+// enter the loop.
+class V8_EXPORT_PRIVATE LoopInvariantCodeMotion final {
+ public:
+  LoopInvariantCodeMotion(Graph* graph, CommonOperatorBuilder* common,
+                          LoopTree* loop_tree, Zone* tmp_zone)
+      : graph_(graph),
+        common_(common),
+        loop_tree_(loop_tree),
+        tmp_zone_(tmp_zone) {}
+
+  // Processes all loops of the tree, inner loops first, such that nodes can
+  // be hoisted across several levels of nesting.
+  void Optimize();
+
+  // Processes a single loop and returns the number of hoisted nodes.
+  size_t OptimizeLoop(LoopTree::Loop* loop);
+
+ private:
+  class LoopEffects;
+
+  void OptimizeLoops(LoopTree::Loop* loop);
+
+  bool IsInvariant(LoopTree::Loop* loop, Node* node,
+                   const ZoneSet<Node*>& hoisted) const;
+  bool CanHoist(LoopTree::Loop* loop, Node* node, const LoopEffects& effects,
+                const ZoneSet<Node*>& hoisted) const;
+
+  // Returns a copy of {state} in which the phis of {loop} are replaced by
+  // their loop entry input, or nullptr if {state} depends on other values
+  // computed inside of the loop.
+  Node* CopyFrameStateForEntry(LoopTree::Loop* loop, Node* loop_node,
+                               Node* state, ZoneMap<Node*, Node*>* copies);
+
+  Graph* graph() const { return graph_; }
+  CommonOperatorBuilder* common() const { return common_; }
+
+  Graph* const graph_;
+  CommonOperatorBuilder* const common_;
+  LoopTree* const loop_tree_;
+  Zone* const tmp_zone_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
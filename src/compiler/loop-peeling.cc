@@ -324,6 +324,178 @@ void LoopPeeler::PeelInnerLoops(LoopTree::Loop* loop) {
   Peel(loop);
 }
 
+bool LoopPeeler::CanUnroll(LoopTree::Loop* loop) {
+  if (!loop->children().empty()) return false;
+  Node* loop_node = loop_tree_->GetLoopControl(loop);
+  if (loop_node->InputCount() != 2) return false;
+  return CanPeel(loop);
+}
+
+// static
+uint32_t LoopPeeler::UnrollingCount(LoopTree::Loop* loop) {
+  size_t count = (loop->depth() + 1) * kMaxUnrolledNodes / loop->TotalSize();
+  if (count > kMaxUnrollingCount) return kMaxUnrollingCount;
+  return static_cast<uint32_t>(count);
+}
+
+// Unrolling a loop {count} times is similar to peeling it {count - 1} times,
+// except that the copies are placed inside of the loop: The backedges of the
+// loop enter the first copy, the backedges of the last copy become the new
+// backedges of the loop, and the exits of all copies are merged in front of
+// the original loop exit markers:
+//
+//      ( Loop )<-------- ( phiA ) <----------------------------+
+//         |                 |                                  |
+//      ((=P=================U===))                             |
+//      ((   body                ))                             |
+//      ((===K=============L=====))                             |
+//           |             |                                    |
+//           |      ((=====U'======))                           |
+//           |      ((   body'     ))                           |
+//           |      ((===K'====L'==))                           |
+//           |           |     +--------------------------------+
+//         Merge <-------+
+//           |
+//       LoopExit
+//
+// The merges and phis in front of the exit markers are part of the loop, so
+// the unrolled loop can still be peeled.
+void LoopPeeler::Unroll(LoopTree::Loop* loop, uint32_t count) {
+  DCHECK(CanUnroll(loop));
+  DCHECK_LE(2u, count);
+
+  Node* dead = graph_->NewNode(common_->Dead());
+  size_t estimated_copy_size = 5 + (loop->TotalSize()) * 2;
+
+  // The values that flow into the next copy, initially the backedge inputs
+  // of the loop header.
+  NodeVector backedges(tmp_zone_);
+  for (Node* node : loop_tree_->HeaderNodes(loop)) {
+    backedges.push_back(node->InputAt(1));
+  }
+  // The inputs of the exit markers in all copies.
+  ZoneVector<NodeVector> exits(tmp_zone_);
+  for (Node* exit : loop_tree_->ExitNodes(loop)) {
+    exits.emplace_back(tmp_zone_);
+    exits.back().push_back(exit->InputAt(0));
+  }
+
+  //============================================================================
+  // Construct the copies of the body, one after the other.
+  //============================================================================
+  for (uint32_t i = 1; i < count; ++i) {
+    NodeVector pairs(tmp_zone_);
+    Peeling copy(graph_, estimated_copy_size, &pairs);
+    size_t index = 0;
+    for (Node* node : loop_tree_->HeaderNodes(loop)) {
+      copy.Insert(node, backedges[index++]);
+    }
+    copy.CopyNodes(graph_, tmp_zone_, dead, loop_tree_->BodyNodes(loop),
+                   source_positions_, node_origins_);
+    index = 0;
+    for (Node* node : loop_tree_->HeaderNodes(loop)) {
+      backedges[index++] = copy.map(node->InputAt(1));
+    }
+    index = 0;
+    for (Node* exit : loop_tree_->ExitNodes(loop)) {
+      exits[index++].push_back(copy.map(exit->InputAt(0)));
+    }
+  }
+
+  //============================================================================
+  // Close the loop with the backedges of the last copy.
+  //============================================================================
+  size_t index = 0;
+  for (Node* node : loop_tree_->HeaderNodes(loop)) {
+    node->ReplaceInput(1, backedges[index++]);
+  }
+
+  //============================================================================
+  // Merge the exits of all copies in front of the exit markers.
+  //============================================================================
+  int const inputs = static_cast<int>(count);
+  index = 0;
+  for (Node* exit : loop_tree_->ExitNodes(loop)) {
+    NodeVector& exit_inputs = exits[index++];
+    if (exit->opcode() != IrOpcode::kLoopExit) continue;
+    Node* merge = graph_->NewNode(common_->Merge(inputs), inputs,
+                                  exit_inputs.data());
+    exit->ReplaceInput(0, merge);
+  }
+  index = 0;
+  for (Node* exit : loop_tree_->ExitNodes(loop)) {
+    NodeVector& exit_inputs = exits[index++];
+    if (exit->opcode() == IrOpcode::kLoopExit) continue;
+    exit_inputs.push_back(NodeProperties::GetControlInput(exit)->InputAt(0));
+    const Operator* op =
+        exit->opcode() == IrOpcode::kLoopExitValue
+            ? common_->Phi(LoopExitValueRepresentationOf(exit->op()), inputs)
+            : common_->EffectPhi(inputs);
+    Node* phi = graph_->NewNode(op, inputs + 1, exit_inputs.data());
+    exit->ReplaceInput(0, phi);
+  }
+}
+
+bool LoopPeeler::HasInductionVariable(LoopTree::Loop* loop) {
+  Node* loop_node = loop_tree_->GetLoopControl(loop);
+  for (Node* phi : loop_tree_->HeaderNodes(loop)) {
+    if (phi->opcode() != IrOpcode::kPhi) continue;
+    Node* arith = phi->InputAt(1);
+    switch (arith->opcode()) {
+      case IrOpcode::kInt32Add:
+      case IrOpcode::kInt32Sub:
+      case IrOpcode::kInt64Add:
+      case IrOpcode::kInt64Sub:
+      case IrOpcode::kNumberAdd:
+      case IrOpcode::kNumberSubtract:
+      case IrOpcode::kSpeculativeNumberAdd:
+      case IrOpcode::kSpeculativeNumberSubtract:
+      case IrOpcode::kSpeculativeSafeIntegerAdd:
+      case IrOpcode::kSpeculativeSafeIntegerSubtract:
+        break;
+      default:
+        continue;
+    }
+    if (arith->InputAt(0) != phi) continue;
+    switch (arith->InputAt(1)->opcode()) {
+      case IrOpcode::kInt32Constant:
+      case IrOpcode::kInt64Constant:
+      case IrOpcode::kNumberConstant:
+        if (FLAG_trace_turbo_loop) {
+          PrintF("Loop %i has induction variable %i\n", loop_node->id(),
+                 phi->id());
+        }
+        return true;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+void LoopPeeler::UnrollInnerLoops(LoopTree::Loop* loop) {
+  // If the loop has nested loops, unroll inside those.
+  if (!loop->children().empty()) {
+    for (LoopTree::Loop* inner_loop : loop->children()) {
+      UnrollInnerLoops(inner_loop);
+    }
+    return;
+  }
+  uint32_t count = UnrollingCount(loop);
+  if (count < 2 || !CanUnroll(loop) || !HasInductionVariable(loop)) return;
+  if (FLAG_trace_turbo_loop) {
+    PrintF("Unrolling loop %i %u times\n",
+           loop_tree_->GetLoopControl(loop)->id(), count);
+  }
+  Unroll(loop, count);
+}
+
+void LoopPeeler::UnrollInnerLoopsOfTree() {
+  for (LoopTree::Loop* loop : loop_tree_->outer_loops()) {
+    UnrollInnerLoops(loop);
+  }
+}
+
 namespace {
 
 void EliminateLoopExit(Node* node) {
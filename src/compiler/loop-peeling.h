@@ -47,8 +47,25 @@ class V8_EXPORT_PRIVATE LoopPeeler {
   PeeledIteration* Peel(LoopTree::Loop* loop);
   void PeelInnerLoopsOfTree();
 
+  // Unrolling copies the body of an innermost loop with a single backedge
+  // such that one iteration of the unrolled loop executes {count} iterations
+  // of the original loop. Every copy keeps its exit checks, so the trip count
+  // of the loop does not need to be known.
+  bool CanUnroll(LoopTree::Loop* loop);
+  void Unroll(LoopTree::Loop* loop, uint32_t count);
+  // Unrolls the small innermost loops that have an induction variable.
+  // Requires the loop exits to be marked, i.e. must run before
+  // {EliminateLoopExits}.
+  void UnrollInnerLoopsOfTree();
+
+  // Returns how many iterations an unrolled copy of {loop} should contain.
+  // Favors small and deeply nested loops.
+  static uint32_t UnrollingCount(LoopTree::Loop* loop);
+
   static void EliminateLoopExits(Graph* graph, Zone* tmp_zone);
   static const size_t kMaxPeeledNodes = 1000;
+  static const size_t kMaxUnrolledNodes = 200;
+  static const uint32_t kMaxUnrollingCount = 4;
 
  private:
   Graph* const graph_;
@@ -59,6 +76,8 @@ class V8_EXPORT_PRIVATE LoopPeeler {
   NodeOriginTable* const node_origins_;
 
   void PeelInnerLoops(LoopTree::Loop* loop);
+  void UnrollInnerLoops(LoopTree::Loop* loop);
+  bool HasInductionVariable(LoopTree::Loop* loop);
 };
 
 
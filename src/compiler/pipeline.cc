@@ -27,6 +27,7 @@
 #include "src/compiler/backend/register-allocator-verifier.h"
 #include "src/compiler/backend/register-allocator.h"
 #include "src/compiler/basic-block-instrumentor.h"
+#include "src/compiler/bounds-check-elimination.h"
 #include "src/compiler/branch-elimination.h"
 #include "src/compiler/bytecode-graph-builder.h"
 #include "src/compiler/checkpoint-elimination.h"
@@ -55,6 +56,7 @@
 #include "src/compiler/js-typed-lowering.h"
 #include "src/compiler/load-elimination.h"
 #include "src/compiler/loop-analysis.h"
+#include "src/compiler/loop-invariant-code-motion.h"
 #include "src/compiler/loop-peeling.h"
 #include "src/compiler/loop-variable-optimizer.h"
 #include "src/compiler/machine-graph-verifier.h"
@@ -1714,6 +1716,27 @@ struct LoopPeelingPhase {
   }
 };
 
+struct LoopUnrollingPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(LoopUnrolling)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    GraphTrimmer trimmer(temp_zone, data->graph());
+    NodeVector roots(temp_zone);
+    if (data->jsgraph()) {
+      data->jsgraph()->GetCachedNodes(&roots);
+    }
+    trimmer.TrimGraph(roots.begin(), roots.end());
+
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(
+        data->graph(), &data->info()->tick_counter(), temp_zone);
+    // The typer, if any, inspects heap objects when typing the copied nodes.
+    UnparkedScopeIfNeeded scope(data->broker());
+    LoopPeeler(data->graph(), data->common(), loop_tree, temp_zone,
+               data->source_positions(), data->node_origins())
+        .UnrollInnerLoopsOfTree();
+  }
+};
+
 struct LoopExitEliminationPhase {
   DECL_PIPELINE_PHASE_CONSTANTS(LoopExitElimination)
 
@@ -1722,6 +1745,18 @@ struct LoopExitEliminationPhase {
   }
 };
 
+struct LoopInvariantCodeMotionPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(LoopInvariantCodeMotion)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(
+        data->jsgraph()->graph(), &data->info()->tick_counter(), temp_zone);
+    LoopInvariantCodeMotion(data->graph(), data->common(), loop_tree,
+                            temp_zone)
+        .Optimize();
+  }
+};
+
 struct GenericLoweringPhase {
   DECL_PIPELINE_PHASE_CONSTANTS(GenericLowering)
 
@@ -1896,6 +1931,22 @@ struct LoadEliminationPhase {
   }
 };
 
+struct BoundsCheckEliminationPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(BoundsCheckElimination)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    BoundsCheckElimination bounds_check_elimination(data->jsgraph(),
+                                                    temp_zone);
+    bounds_check_elimination.Run();
+
+    Counters* counters = data->isolate()->counters();
+    counters->turbofan_bounds_checks_eliminated()->Increment(
+        static_cast<int>(bounds_check_elimination.eliminated_checks()));
+    counters->turbofan_bounds_checks_merged()->Increment(
+        static_cast<int>(bounds_check_elimination.merged_checks()));
+  }
+};
+
 struct MemoryOptimizationPhase {
   DECL_PIPELINE_PHASE_CONSTANTS(MemoryOptimization)
 
@@ -2548,6 +2599,11 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   Run<TypedLoweringPhase>();
   RunPrintAndVerify(TypedLoweringPhase::phase_name());
 
+  if (FLAG_turbo_loop_unrolling) {
+    Run<LoopUnrollingPhase>();
+    RunPrintAndVerify(LoopUnrollingPhase::phase_name(), true);
+  }
+
   if (data->info()->loop_peeling()) {
     Run<LoopPeelingPhase>();
     RunPrintAndVerify(LoopPeelingPhase::phase_name(), true);
@@ -2556,10 +2612,24 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
     RunPrintAndVerify(LoopExitEliminationPhase::phase_name(), true);
   }
 
+  if (FLAG_turbo_loop_invariant_code_motion) {
+    Run<LoopInvariantCodeMotionPhase>();
+    RunPrintAndVerify(LoopInvariantCodeMotionPhase::phase_name(), true);
+  }
+
   if (FLAG_turbo_load_elimination) {
     Run<LoadEliminationPhase>();
     RunPrintAndVerify(LoadEliminationPhase::phase_name());
   }
+
+  // Removing bounds checks also removes the speculation barriers that
+  // poisoning relies on.
+  if (FLAG_turbo_bounds_check_elimination &&
+      data->info()->GetPoisoningMitigationLevel() ==
+          PoisoningMitigationLevel::kDontPoison) {
+    Run<BoundsCheckEliminationPhase>();
+    RunPrintAndVerify(BoundsCheckEliminationPhase::phase_name(), true);
+  }
   data->DeleteTyper();
 
   if (FLAG_turbo_escape) {
@@ -3156,6 +3226,8 @@ void Pipeline::GenerateCodeForWasmFunction(
   pipeline.RunPrintAndVerify("V8.WasmMachineCode", true);
 
   if (FLAG_wasm_loop_unrolling) {
+    pipeline.Run<LoopUnrollingPhase>();
+    pipeline.RunPrintAndVerify(LoopUnrollingPhase::phase_name(), true);
     pipeline.Run<LoopExitEliminationPhase>();
     pipeline.RunPrintAndVerify("V8.LoopExitEliminationPhase", true);
   }
@@ -4,6 +4,8 @@
 
 #include "src/execution/runtime-profiler.h"
 
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
 #include "src/codegen/assembler.h"
 #include "src/codegen/compilation-cache.h"
@@ -12,6 +14,7 @@
 #include "src/diagnostics/code-tracer.h"
 #include "src/execution/execution.h"
 #include "src/execution/frames-inl.h"
+#include "src/execution/warmup-profile.h"
 #include "src/handles/global-handles.h"
 #include "src/init/bootstrapper.h"
 #include "src/interpreter/interpreter.h"
@@ -48,10 +51,42 @@ static const int kMaxBytecodeSizeForEarlyOpt = 90;
 // FLAG_ticks_scale_factor_for_top_tier.
 static const int kProfilerTicksForTurboPropOSR = 4 * 10;
 
+// Serializes writes to FLAG_warmup_profile_out by the isolates of the process.
+static base::LazyMutex warmup_profile_out_mutex = LAZY_MUTEX_INITIALIZER;
+static bool warmup_profile_out_written = false;
+
+namespace {
+
+// The profile from FLAG_warmup_profile_in. It is read by the first isolate and
+// shared with all isolates of the process.
+struct WarmupProfileIn {
+  WarmupProfileIn() {
+    bool success = profile.ReadFromFile(FLAG_warmup_profile_in);
+    // A missing profile is expected the first time a service is started with
+    // a profile path, so this is only traced.
+    if (FLAG_trace_warmup_profile) {
+      if (success) {
+        PrintF("[warmup profile: read %zu functions from %s]\n",
+               profile.hinted_count(), FLAG_warmup_profile_in);
+      } else {
+        PrintF("[warmup profile: could not read %s]\n",
+               FLAG_warmup_profile_in);
+      }
+    }
+  }
+
+  WarmupProfile profile;
+};
+
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(WarmupProfileIn, GetWarmupProfileIn)
+
+}  // namespace
+
 #define OPTIMIZATION_REASON_LIST(V)   \
   V(DoNotOptimize, "do not optimize") \
   V(HotAndStable, "hot and stable")   \
-  V(SmallFunction, "small function")
+  V(SmallFunction, "small function")  \
+  V(WarmupProfile, "warmup profile")
 
 enum class OptimizationReason : uint8_t {
 #define OPTIMIZATION_REASON_CONSTANTS(Constant, message) k##Constant,
@@ -121,15 +156,58 @@ void TraceRecompile(JSFunction function, OptimizationReason reason,
 }  // namespace
 
 RuntimeProfiler::RuntimeProfiler(Isolate* isolate)
-    : isolate_(isolate), any_ic_changed_(false) {}
+    : isolate_(isolate), any_ic_changed_(false) {
+  if (FLAG_warmup_profile_in == nullptr && FLAG_warmup_profile_out == nullptr) {
+    return;
+  }
+  warmup_profile_ = std::make_unique<WarmupProfile>();
+  if (FLAG_warmup_profile_in != nullptr) {
+    warmup_profile_->Merge(GetWarmupProfileIn()->profile);
+  }
+}
+
+RuntimeProfiler::~RuntimeProfiler() = default;
 
 void RuntimeProfiler::Optimize(JSFunction function, OptimizationReason reason,
                                CodeKind code_kind) {
   DCHECK_NE(reason, OptimizationReason::kDoNotOptimize);
   TraceRecompile(function, reason, code_kind, isolate_);
+  if (V8_UNLIKELY(warmup_profile_ != nullptr)) {
+    warmup_profile_->RecordOptimization(function.shared());
+  }
   function.MarkForOptimization(ConcurrencyMode::kConcurrent);
 }
 
+void RuntimeProfiler::NotifyFeedbackVectorAllocated(JSFunction function) {
+  if (V8_LIKELY(warmup_profile_ == nullptr)) return;
+  // Functions which were optimized in the profiled run get their first tick
+  // as soon as they have collected some feedback, see ShouldOptimize.
+  if (warmup_profile_->IsHinted(function.shared())) {
+    function.raw_feedback_cell().set_interrupt_budget(
+        FLAG_warmup_profile_interrupt_budget);
+  }
+}
+
+void RuntimeProfiler::WriteWarmupProfile() {
+  if (warmup_profile_ == nullptr || FLAG_warmup_profile_out == nullptr) return;
+  // All isolates of the process write to the same file. The first one
+  // replaces the profile of the previous run, the others merge into it.
+  base::MutexGuard guard(warmup_profile_out_mutex.Pointer());
+  if (warmup_profile_out_written) {
+    warmup_profile_->ReadFromFile(FLAG_warmup_profile_out);
+  }
+  warmup_profile_out_written = true;
+  if (!warmup_profile_->WriteToFile(FLAG_warmup_profile_out)) {
+    PrintF(stderr, "Could not write warmup profile %s\n",
+           FLAG_warmup_profile_out);
+  }
+}
+
+void RuntimeProfiler::SetWarmupProfileForTesting(
+    std::unique_ptr<WarmupProfile> warmup_profile) {
+  warmup_profile_ = std::move(warmup_profile);
+}
+
 void RuntimeProfiler::AttemptOnStackReplacement(InterpretedFrame* frame,
                                                 int loop_nesting_levels) {
   JSFunction function = frame->function();
@@ -241,13 +319,12 @@ bool ShouldOptimizeAsSmallFunction(int bytecode_size, int ticks,
   // Without turboprop we always allow early optimizations for small functions
   if (!FLAG_turboprop) return true;
   // For turboprop, we only do small function optimizations when tiering up from
-  // TP-> TF. We should also scale the ticks, so we optimize small functions
-  // when reaching one tick for top tier.
+  // TP-> TF. Mid-tier code ticks with FLAG_interrupt_budget_for_midtier, so a
+  // single tick there corresponds to a tick for the top tier.
   // TODO(turboprop, mythria): Investigate if small function optimization is
   // required at all and avoid this if possible by changing the heuristics to
   // take function size into account.
-  return active_tier_is_turboprop &&
-         ticks > FLAG_ticks_scale_factor_for_top_tier;
+  return active_tier_is_turboprop && ticks > 0;
 }
 
 }  // namespace
@@ -260,14 +337,18 @@ OptimizationReason RuntimeProfiler::ShouldOptimize(JSFunction function,
   if (V8_UNLIKELY(FLAG_turboprop) && function.ActiveTierIsToptierTurboprop()) {
     return OptimizationReason::kDoNotOptimize;
   }
+  if (V8_UNLIKELY(warmup_profile_ != nullptr) &&
+      function.ActiveTierIsIgnition() &&
+      warmup_profile_->TakeHint(function.shared())) {
+    return OptimizationReason::kWarmupProfile;
+  }
   int ticks = function.feedback_vector().profiler_ticks();
   bool active_tier_is_turboprop = function.ActiveTierIsMidtierTurboprop();
-  int scale_factor =
-      active_tier_is_turboprop ? FLAG_ticks_scale_factor_for_top_tier : 1;
+  // Ticks of mid-tier code are counted with their own interrupt budget, so
+  // they don't need to be scaled to match the ones for the top tier.
   int ticks_for_optimization =
       kProfilerTicksBeforeOptimization +
       (bytecode.length() / kBytecodeSizeAllowancePerTick);
-  ticks_for_optimization *= scale_factor;
   if (ticks >= ticks_for_optimization) {
     return OptimizationReason::kHotAndStable;
   } else if (ShouldOptimizeAsSmallFunction(bytecode.length(), ticks,
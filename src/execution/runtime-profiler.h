@@ -5,6 +5,8 @@
 #ifndef V8_EXECUTION_RUNTIME_PROFILER_H_
 #define V8_EXECUTION_RUNTIME_PROFILER_H_
 
+#include <memory>
+
 #include "src/common/assert-scope.h"
 #include "src/handles/handles.h"
 #include "src/utils/allocation.h"
@@ -17,12 +19,14 @@ class Isolate;
 class InterpretedFrame;
 class JavaScriptFrame;
 class JSFunction;
+class WarmupProfile;
 enum class CodeKind;
 enum class OptimizationReason : uint8_t;
 
 class RuntimeProfiler {
  public:
   explicit RuntimeProfiler(Isolate* isolate);
+  ~RuntimeProfiler();
 
   // Called from the interpreter when the bytecode interrupt has been exhausted.
   void MarkCandidatesForOptimizationFromBytecode();
@@ -31,6 +35,17 @@ class RuntimeProfiler {
 
   void NotifyICChanged() { any_ic_changed_ = true; }
 
+  // Called when the interpreter allocates the feedback vector of {function}.
+  void NotifyFeedbackVectorAllocated(JSFunction function);
+
+  // Writes the functions marked for optimization so far to
+  // FLAG_warmup_profile_out, if given. Isolates of the same process add to
+  // the profile written by the first one instead of replacing it.
+  void WriteWarmupProfile();
+
+  V8_EXPORT_PRIVATE void SetWarmupProfileForTesting(
+      std::unique_ptr<WarmupProfile> warmup_profile);
+
   void AttemptOnStackReplacement(InterpretedFrame* frame,
                                  int nesting_levels = 1);
 
@@ -65,6 +80,7 @@ class RuntimeProfiler {
 
   Isolate* isolate_;
   bool any_ic_changed_;
+  std::unique_ptr<WarmupProfile> warmup_profile_;
 };
 
 }  // namespace internal
@@ -0,0 +1,124 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/execution/warmup-profile.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#include "src/base/platform/platform.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+#include "src/objects/string-inl.h"
+
+namespace v8 {
+namespace internal {
+
+bool WarmupProfile::Key::operator<(const Key& other) const {
+  return std::tie(script_name, source_length, start_position, end_position) <
+         std::tie(other.script_name, other.source_length, other.start_position,
+                  other.end_position);
+}
+
+// static
+bool WarmupProfile::GetKey(SharedFunctionInfo shared, Key* key) {
+  if (!shared.IsUserJavaScript()) return false;
+  Object maybe_script = shared.script();
+  if (!maybe_script.IsScript()) return false;
+  Script script = Script::cast(maybe_script);
+  if (!script.name().IsString() || !script.source().IsString()) return false;
+  String name = String::cast(script.name());
+  if (name.length() == 0) return false;
+  key->script_name = name.ToCString().get();
+  // The name ends the line it is written to.
+  if (key->script_name.find('\n') != std::string::npos) return false;
+  key->source_length = String::cast(script.source()).length();
+  key->start_position = shared.StartPosition();
+  key->end_position = shared.EndPosition();
+  return true;
+}
+
+bool WarmupProfile::Read(std::istream& stream) {
+  // Nothing is added unless the whole profile is well-formed.
+  std::set<Key> keys;
+  for (std::string line; std::getline(stream, line);) {
+    if (line.empty()) continue;
+    std::istringstream line_stream(line);
+    Key key;
+    char separator[3];
+    line_stream >> key.source_length >> separator[0] >> key.start_position >>
+        separator[1] >> key.end_position >> separator[2];
+    if (line_stream.fail() || separator[0] != ',' || separator[1] != ',' ||
+        separator[2] != ',') {
+      return false;
+    }
+    std::getline(line_stream, key.script_name);
+    if (key.script_name.empty()) return false;
+    keys.insert(std::move(key));
+  }
+  hinted_.insert(keys.begin(), keys.end());
+  recorded_.insert(keys.begin(), keys.end());
+  return true;
+}
+
+void WarmupProfile::Write(std::ostream& stream) const {
+  for (const Key& key : recorded_) {
+    stream << key.source_length << ',' << key.start_position << ','
+           << key.end_position << ',' << key.script_name << '\n';
+  }
+}
+
+void WarmupProfile::Merge(const WarmupProfile& other) {
+  hinted_.insert(other.hinted_.begin(), other.hinted_.end());
+  recorded_.insert(other.recorded_.begin(), other.recorded_.end());
+}
+
+bool WarmupProfile::ReadFromFile(const char* filename) {
+  std::ifstream file(filename);
+  return file.good() && Read(file);
+}
+
+bool WarmupProfile::WriteToFile(const char* filename) const {
+  // Write a file of our own and move it over the profile, so that a crash or
+  // another process writing the same profile never leaves a torn file behind.
+  std::string temp_filename = std::string(filename) + ".tmp." +
+                              std::to_string(base::OS::GetCurrentProcessId());
+  bool success;
+  {
+    std::ofstream file(temp_filename);
+    Write(file);
+    file.close();
+    success = file.good();
+  }
+  if (success && std::rename(temp_filename.c_str(), filename) != 0) {
+    // Windows does not replace existing files.
+    std::remove(filename);
+    success = std::rename(temp_filename.c_str(), filename) == 0;
+  }
+  if (!success) std::remove(temp_filename.c_str());
+  return success;
+}
+
+void WarmupProfile::RecordOptimization(SharedFunctionInfo shared) {
+  Key key;
+  if (GetKey(shared, &key)) recorded_.insert(std::move(key));
+}
+
+bool WarmupProfile::IsHinted(SharedFunctionInfo shared) const {
+  if (hinted_.empty()) return false;
+  Key key;
+  return GetKey(shared, &key) && hinted_.count(key) != 0;
+}
+
+bool WarmupProfile::TakeHint(SharedFunctionInfo shared) {
+  if (hinted_.empty()) return false;
+  Key key;
+  return GetKey(shared, &key) && hinted_.erase(key) != 0;
+}
+
+}  // namespace internal
+}  // namespace v8
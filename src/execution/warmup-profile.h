@@ -0,0 +1,85 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_EXECUTION_WARMUP_PROFILE_H_
+#define V8_EXECUTION_WARMUP_PROFILE_H_
+
+#include <iosfwd>
+#include <set>
+#include <string>
+
+#include "src/base/macros.h"
+
+namespace v8 {
+namespace internal {
+
+class SharedFunctionInfo;
+
+// The set of functions which the RuntimeProfiler decided to optimize, in a
+// form that can be persisted across processes. Feedback itself refers to maps
+// and other heap objects and can't outlive the isolate, so functions are
+// identified by their position in a named script instead. A profile read at
+// startup lets those functions be optimized as soon as they have collected
+// a first round of feedback, rather than after the usual number of ticks.
+//
+// The textual format has one function per line:
+//
+//   <source length>,<start position>,<end position>,<script name>
+//
+// Entries that don't match the running scripts anymore are harmless: they are
+// either never looked up or only cause a function to be optimized early.
+class V8_EXPORT_PRIVATE WarmupProfile final {
+ public:
+  WarmupProfile() = default;
+  WarmupProfile(const WarmupProfile&) = delete;
+  WarmupProfile& operator=(const WarmupProfile&) = delete;
+
+  // Adds the functions from a profile written by Write() to the hints and to
+  // the recorded functions. Returns false and adds nothing if {stream} is
+  // malformed.
+  bool Read(std::istream& stream);
+  void Write(std::ostream& stream) const;
+
+  // Adds the hints and the recorded functions of {other}.
+  void Merge(const WarmupProfile& other);
+
+  bool ReadFromFile(const char* filename);
+  // Replaces {filename} atomically with a file written by Write().
+  bool WriteToFile(const char* filename) const;
+
+  // Records that {shared} has been marked for optimization.
+  void RecordOptimization(SharedFunctionInfo shared);
+
+  // Returns whether {shared} was optimized in the run that produced the
+  // profile.
+  bool IsHinted(SharedFunctionInfo shared) const;
+  // Like IsHinted, but also drops the hint so that a function which keeps
+  // deoptimizing falls back to the regular heuristics.
+  bool TakeHint(SharedFunctionInfo shared);
+
+  size_t hinted_count() const { return hinted_.size(); }
+  size_t recorded_count() const { return recorded_.size(); }
+
+ private:
+  struct Key {
+    int source_length;
+    int start_position;
+    int end_position;
+    std::string script_name;
+
+    bool operator<(const Key& other) const;
+  };
+
+  // Returns false for functions without a stable identity, i.e. those which
+  // aren't user JavaScript or come from scripts without a name.
+  static bool GetKey(SharedFunctionInfo shared, Key* key);
+
+  std::set<Key> hinted_;
+  std::set<Key> recorded_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_EXECUTION_WARMUP_PROFILE_H_
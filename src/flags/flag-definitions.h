@@ -455,6 +455,11 @@ DEFINE_IMPLICATION(trace_code_dependencies, trace_deopt_verbose)
 // Flags for experimental implementation features.
 DEFINE_BOOL(allocation_site_pretenuring, true,
             "pretenure with allocation sites")
+DEFINE_BOOL(sampled_pretenuring, false,
+            "pretenure allocation sites based on sampled object lifetimes")
+DEFINE_INT(sampled_pretenuring_interval, 64 * KB,
+           "average number of young generation bytes allocated between two "
+           "lifetime samples")
 DEFINE_BOOL(page_promotion, true, "promote pages based on utilization")
 DEFINE_BOOL_READONLY(always_promote_young_mc, true,
                      "always promote young objects during mark-compact")
@@ -500,6 +505,19 @@ DEFINE_BOOL_READONLY(string_slices, true, "use string slices")
 DEFINE_INT(interrupt_budget, 144 * KB,
            "interrupt budget which should be used for the profiler counter")
 
+// Flags for persisting tiering decisions across processes.
+DEFINE_STRING(warmup_profile_in, nullptr,
+              "read the functions to optimize early from the given warmup "
+              "profile")
+DEFINE_STRING(warmup_profile_out, nullptr,
+              "write the functions marked for optimization to the given "
+              "warmup profile on isolate teardown, merging those of all "
+              "isolates of the process")
+DEFINE_INT(warmup_profile_interrupt_budget, 8 * KB,
+           "interrupt budget for functions in the warmup profile until they "
+           "get their first profiler tick")
+DEFINE_BOOL(trace_warmup_profile, false, "trace reading of the warmup profile")
+
 // Flags for inline caching and feedback vectors.
 DEFINE_BOOL(use_ic, true, "use inline caching")
 DEFINE_INT(budget_for_feedback_vector_allocation, 1 * KB,
@@ -562,11 +580,19 @@ DEFINE_VALUE_IMPLICATION(turboprop, interrupt_budget, 15 * KB)
 DEFINE_VALUE_IMPLICATION(turboprop, reuse_opt_code_count, 2)
 DEFINE_UINT_READONLY(max_minimorphic_map_checks, 4,
                      "max number of map checks to perform in minimorphic state")
-// Since Turboprop uses much lower value for interrupt budget, we need to wait
-// for a higher number of ticks to tierup to Turbofan roughly match the default.
-// The default of 10 is approximately the ration of TP to TF interrupt budget.
+// Mid-tier code counts its ticks with its own budget, so that tiering up to
+// Turbofan from there takes roughly as long as it does from the interpreter
+// without Turboprop.
+DEFINE_INT(interrupt_budget_for_midtier, 144 * KB,
+           "interrupt budget which should be used for the profiler counter "
+           "in mid-tier code")
+// Since Turboprop uses much lower value for interrupt budget in the
+// interpreter, we need to wait for a higher number of ticks before attempting
+// OSR to roughly match the default. The default of 10 is approximately the
+// ratio of TP to TF interrupt budget.
 DEFINE_INT(ticks_scale_factor_for_top_tier, 10,
-           "scale factor for profiler ticks when tiering up from midtier")
+           "scale factor for profiler ticks when attempting OSR with a "
+           "midtier")
 
 // Flags for concurrent recompilation.
 DEFINE_BOOL(concurrent_recompilation, true,
@@ -699,6 +725,10 @@ DEFINE_BOOL(trace_environment_liveness, false,
 DEFINE_BOOL(turbo_load_elimination, true, "enable load elimination in TurboFan")
 DEFINE_BOOL(trace_turbo_load_elimination, false,
             "trace TurboFan load elimination")
+DEFINE_BOOL(turbo_bounds_check_elimination, false,
+            "enable bounds check elimination in TurboFan")
+DEFINE_BOOL(trace_turbo_bounds_check_elimination, false,
+            "trace TurboFan bounds check elimination")
 DEFINE_BOOL(turbo_profiling, false, "enable basic block profiling in TurboFan")
 DEFINE_BOOL(turbo_profiling_verbose, false,
             "enable basic block profiling in TurboFan, and include each "
@@ -714,6 +744,10 @@ DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_loop_peeling, true, "Turbofan loop peeling")
 DEFINE_BOOL(turbo_loop_variable, true, "Turbofan loop variable optimization")
 DEFINE_BOOL(turbo_loop_rotation, true, "Turbofan loop rotation")
+DEFINE_BOOL(turbo_loop_unrolling, false,
+            "Turbofan loop unrolling of small counted loops")
+DEFINE_BOOL(turbo_loop_invariant_code_motion, false,
+            "Turbofan loop-invariant code motion")
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_escape, true, "enable escape analysis")
 DEFINE_BOOL(turbo_allocation_folding, true, "Turbofan allocation folding")
@@ -883,8 +917,7 @@ DEFINE_BOOL(wasm_math_intrinsics, true,
             "intrinsify some Math imports into wasm")
 
 DEFINE_BOOL(wasm_loop_unrolling, false,
-            "generate and then remove loop exits in wasm turbofan code "
-            "(placeholder for future loop unrolling feature)")
+            "unroll small counted loops in wasm turbofan code")
 DEFINE_BOOL(wasm_trap_handler, true,
             "use signal handlers to catch out of bounds memory access in wasm"
             " (currently Linux x86_64 only)")
@@ -936,6 +969,11 @@ DEFINE_SIZE_T(max_semi_space_size, 0,
               "max size of a semi-space (in MBytes), the new space consists of "
               "two semi-spaces")
 DEFINE_INT(semi_space_growth_factor, 2, "factor by which to grow the new space")
+DEFINE_BOOL(adaptive_semi_space_sizing, false,
+            "size the semi-spaces based on the young generation survival rate "
+            "and the scavenge pause target")
+DEFINE_FLOAT(scavenge_pause_target_ms, 1.0,
+             "target pause time (in ms) used by adaptive semi-space sizing")
 DEFINE_SIZE_T(max_old_space_size, 0, "max size of the old space (in Mbytes)")
 DEFINE_SIZE_T(
     max_heap_size, 0,
@@ -1015,7 +1053,17 @@ DEFINE_INT(scavenge_task_trigger, 80,
 DEFINE_BOOL(scavenge_separate_stack_scanning, false,
             "use a separate phase for stack scanning in scavenge")
 DEFINE_BOOL(trace_parallel_scavenge, false, "trace parallel scavenge")
+DEFINE_BOOL(concurrent_remembered_set_filtering, false,
+            "remove old-to-new slots that no longer point into the young "
+            "generation on background threads between scavenges")
 DEFINE_BOOL(write_protect_code_memory, true, "write protect code memory")
+DEFINE_BOOL(mergeable_read_only_pages, false,
+            "allow the OS to deduplicate sealed read-only space pages across "
+            "processes (KSM on Linux); only has an effect with pointer "
+            "compression and a fixed --hash-seed")
+DEFINE_BOOL(huge_pages_for_old_space, false,
+            "pack old and code space pages into 2MB regions and ask the OS to "
+            "back them with transparent huge pages")
 #if defined(V8_ATOMIC_MARKING_STATE) && defined(V8_ATOMIC_OBJECT_FIELD_WRITES)
 #define V8_CONCURRENT_MARKING_BOOL true
 #else
@@ -1026,6 +1074,9 @@ DEFINE_BOOL(concurrent_marking, V8_CONCURRENT_MARKING_BOOL,
 DEFINE_BOOL(concurrent_array_buffer_sweeping, true,
             "concurrently sweep array buffers")
 DEFINE_BOOL(concurrent_allocation, true, "concurrently allocate in old space")
+DEFINE_BOOL(concurrent_new_space_allocation, false,
+            "give background threads their own allocation buffers in new "
+            "space")
 DEFINE_BOOL(stress_concurrent_allocation, false,
             "start background threads that allocate memory")
 DEFINE_BOOL(local_heaps, true, "allow heap access from background tasks")
@@ -1037,15 +1088,26 @@ DEFINE_NEG_NEG_IMPLICATION(local_heaps, concurrent_allocation)
 DEFINE_NEG_NEG_IMPLICATION(concurrent_allocation,
                            finalize_streaming_on_background)
 DEFINE_NEG_NEG_IMPLICATION(concurrent_allocation, stress_concurrent_allocation)
+DEFINE_NEG_NEG_IMPLICATION(concurrent_allocation,
+                           concurrent_new_space_allocation)
+DEFINE_NEG_IMPLICATION(single_generation, concurrent_new_space_allocation)
 DEFINE_BOOL(parallel_marking, V8_CONCURRENT_MARKING_BOOL,
             "use parallel marking in atomic pause")
+DEFINE_BOOL(parallel_weak_collection_clearing, false,
+            "clear dead entries of weak collections on background threads")
 DEFINE_INT(ephemeron_fixpoint_iterations, 10,
            "number of fixpoint iterations it takes to switch to linear "
            "ephemeron algorithm")
+DEFINE_INT(marking_prefetch_distance, 0,
+           "number of objects that the main thread and concurrent markers "
+           "prefetch ahead of visiting them (0 disables prefetching)")
 DEFINE_BOOL(trace_concurrent_marking, false, "trace concurrent marking")
 DEFINE_BOOL(concurrent_store_buffer, true,
             "use concurrent store buffer processing")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
+DEFINE_BOOL(concurrent_code_space_sweeping, false,
+            "also sweep code space concurrently, requires "
+            "--no-write-protect-code-memory")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
@@ -1113,6 +1175,12 @@ DEFINE_BOOL(always_compact, false, "Perform compaction on every full GC")
 DEFINE_BOOL(never_compact, false,
             "Never perform compaction on full GC - testing only")
 DEFINE_BOOL(compact_code_space, true, "Compact code space on full collections")
+DEFINE_BOOL(compaction_cost_model, false,
+            "select evacuation candidates by weighing evacuation cost against "
+            "reclaimed memory")
+DEFINE_FLOAT(compaction_time_budget_ms, 2.0,
+             "old space evacuation time budget for --compaction-cost-model, "
+             "code space gets a quarter of it")
 DEFINE_BOOL(flush_bytecode, true,
             "flush of bytecode when it has not been executed recently")
 DEFINE_BOOL(stress_flush_bytecode, false, "stress bytecode flushing")
@@ -1352,6 +1420,8 @@ DEFINE_BOOL(heap_profiler_use_embedder_graph, true,
             "Use the new EmbedderGraph API to get embedder nodes")
 DEFINE_INT(heap_snapshot_string_limit, 1024,
            "truncate strings to this length in the heap snapshot")
+DEFINE_BOOL(profile_heap_snapshot, false,
+            "dump time spent in the phases of heap snapshot generation")
 
 // sampling-heap-profiler.cc
 DEFINE_BOOL(sampling_heap_profiler_suppress_randomness, false,
@@ -1926,12 +1996,14 @@ DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_sweeping)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_compaction)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_marking)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_pointer_update)
+DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_weak_collection_clearing)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_scavenge)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_store_buffer)
 #ifdef ENABLE_MINOR_MC
 DEFINE_NEG_IMPLICATION(single_threaded_gc, minor_mc_parallel_marking)
 #endif  // ENABLE_MINOR_MC
 DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_array_buffer_sweeping)
+DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_remembered_set_filtering)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, stress_concurrent_allocation)
 
 #undef FLAG
@@ -0,0 +1,188 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/allocation-lifetime-profiler.h"
+
+#include <algorithm>
+
+#include "src/execution/frames-inl.h"
+#include "src/execution/isolate.h"
+#include "src/handles/global-handles.h"
+#include "src/heap/heap-inl.h"
+#include "src/interpreter/bytecode-array-accessor.h"
+#include "src/objects/allocation-site-inl.h"
+#include "src/objects/feedback-vector-inl.h"
+
+namespace v8 {
+namespace internal {
+
+AllocationLifetimeProfiler::AllocationLifetimeProfiler(Heap* heap,
+                                                       intptr_t sample_interval)
+    : isolate_(heap->isolate()), observer_(this, sample_interval) {}
+
+AllocationLifetimeProfiler::~AllocationLifetimeProfiler() {
+  for (auto& sample : samples_) {
+    if (sample->object != nullptr) GlobalHandles::Destroy(sample->object);
+  }
+  for (auto& site : sites_) {
+    if (site->site != nullptr) GlobalHandles::Destroy(site->site);
+  }
+}
+
+void AllocationLifetimeProfiler::Observer::Step(int bytes_allocated,
+                                                Address soon_object,
+                                                size_t size) {
+  DCHECK_EQ(profiler_->isolate_->heap()->gc_state(), Heap::NOT_IN_GC);
+  if (!soon_object) return;
+  if (profiler_->samples_.size() >= kMaxPendingSamples) return;
+  DisallowGarbageCollection no_gc;
+  Object site = profiler_->CurrentAllocationSite();
+  if (!site.IsAllocationSite()) return;
+  profiler_->SampleObject(soon_object, AllocationSite::cast(site));
+}
+
+Object AllocationLifetimeProfiler::CurrentAllocationSite() {
+  JavaScriptFrameIterator it(isolate_);
+  if (it.done() || !it.frame()->is_interpreted()) return Object();
+  InterpretedFrame* frame = InterpretedFrame::cast(it.frame());
+  JSFunction function = frame->function();
+  if (!function.has_feedback_vector()) return Object();
+
+  HandleScope scope(isolate_);
+  interpreter::BytecodeArrayAccessor accessor(
+      handle(frame->GetBytecodeArray(), isolate_), frame->GetBytecodeOffset());
+  FeedbackSlot slot;
+  switch (accessor.current_bytecode()) {
+    case interpreter::Bytecode::kCreateArrayLiteral:
+    case interpreter::Bytecode::kCreateObjectLiteral:
+      slot = accessor.GetSlotOperand(1);
+      break;
+    case interpreter::Bytecode::kCreateEmptyArrayLiteral:
+      slot = accessor.GetSlotOperand(0);
+      break;
+    default:
+      return Object();
+  }
+
+  HeapObject literal_site;
+  if (!function.feedback_vector().Get(slot)->GetHeapObjectIfStrong(
+          &literal_site) ||
+      !literal_site.IsAllocationSite()) {
+    return Object();
+  }
+  return literal_site;
+}
+
+void AllocationLifetimeProfiler::SampleObject(Address soon_object,
+                                              AllocationSite site) {
+  // Sites that are already tenured cannot change their decision anymore.
+  if (site.IsZombie() || site.pretenure_decision() == AllocationSite::kTenure) {
+    return;
+  }
+  SiteProfile* profile = FindOrAddSite(site);
+  if (profile == nullptr) return;
+
+  // Like the SamplingHeapProfiler, the area at |soon_object| is a filler at
+  // this point, which is replaced by the actual object right after the step.
+  DCHECK((*ObjectSlot(soon_object)).IsMap());
+  auto sample = std::make_unique<Sample>();
+  sample->object = isolate_->global_handles()
+                       ->Create(HeapObject::FromAddress(soon_object))
+                       .location();
+  GlobalHandles::MakeWeak(&sample->object);
+  sample->site = profile;
+  samples_.push_back(std::move(sample));
+}
+
+AllocationLifetimeProfiler::SiteProfile*
+AllocationLifetimeProfiler::FindOrAddSite(AllocationSite site) {
+  for (auto& profile : sites_) {
+    if (profile->site != nullptr && Object(*profile->site) == site) {
+      return profile.get();
+    }
+  }
+  if (sites_.size() >= kMaxTrackedSites) return nullptr;
+  auto profile = std::make_unique<SiteProfile>();
+  profile->site = isolate_->global_handles()->Create(site).location();
+  GlobalHandles::MakeWeak(&profile->site);
+  sites_.push_back(std::move(profile));
+  return sites_.back().get();
+}
+
+bool AllocationLifetimeProfiler::ProcessSamples() {
+  // Step 1: Resolve samples whose object was either promoted or collected.
+  // Objects that are still young stay pending until a later GC.
+  auto resolved = std::remove_if(
+      samples_.begin(), samples_.end(), [](std::unique_ptr<Sample>& sample) {
+        if (sample->object == nullptr) {
+          sample->site->died++;
+          return true;
+        }
+        if (Heap::InYoungGeneration(Object(*sample->object))) return false;
+        sample->site->survived++;
+        GlobalHandles::Destroy(sample->object);
+        return true;
+      });
+  samples_.erase(resolved, samples_.end());
+
+  // Step 2: Make decisions for sites with enough samples.
+  bool trigger_deoptimization = false;
+  for (auto& profile : sites_) {
+    if (profile->site == nullptr) continue;
+    if (MakePretenureDecision(profile.get())) trigger_deoptimization = true;
+  }
+
+  // Step 3: Drop sites that died or were tenured and have no pending samples.
+  auto unused = std::remove_if(
+      sites_.begin(), sites_.end(), [this](std::unique_ptr<SiteProfile>& p) {
+        if (p->site != nullptr &&
+            AllocationSite::cast(Object(*p->site)).pretenure_decision() !=
+                AllocationSite::kTenure) {
+          return false;
+        }
+        for (auto& sample : samples_) {
+          if (sample->site == p.get()) return false;
+        }
+        if (p->site != nullptr) GlobalHandles::Destroy(p->site);
+        return true;
+      });
+  sites_.erase(unused, sites_.end());
+  return trigger_deoptimization;
+}
+
+bool AllocationLifetimeProfiler::MakePretenureDecision(SiteProfile* profile) {
+  const int resolved = profile->survived + profile->died;
+  if (resolved < kMinResolvedSamples) return false;
+
+  AllocationSite site = AllocationSite::cast(Object(*profile->site));
+  AllocationSite::PretenureDecision current_decision =
+      site.pretenure_decision();
+  const double ratio = static_cast<double>(profile->survived) / resolved;
+  bool deopt = false;
+  if (current_decision != AllocationSite::kTenure && !site.IsZombie() &&
+      ratio >= AllocationSite::kPretenureRatio) {
+    site.set_deopt_dependent_code(true);
+    site.set_pretenure_decision(AllocationSite::kTenure);
+    deopt = true;
+  }
+
+  if (FLAG_trace_pretenuring_statistics) {
+    PrintIsolate(isolate_,
+                 "pretenuring: sampled AllocationSite(%p): (survived, died, "
+                 "ratio) (%d, %d, %f) %s => %s\n",
+                 reinterpret_cast<void*>(site.ptr()), profile->survived,
+                 profile->died, ratio,
+                 site.PretenureDecisionName(current_decision),
+                 site.PretenureDecisionName(site.pretenure_decision()));
+  }
+
+  // Start a new sampling window so that the decision tracks phase changes of
+  // the program.
+  profile->survived = 0;
+  profile->died = 0;
+  return deopt;
+}
+
+}  // namespace internal
+}  // namespace v8
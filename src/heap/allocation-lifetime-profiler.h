@@ -0,0 +1,102 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_ALLOCATION_LIFETIME_PROFILER_H_
+#define V8_HEAP_ALLOCATION_LIFETIME_PROFILER_H_
+
+#include <memory>
+#include <vector>
+
+#include "src/common/globals.h"
+#include "src/heap/allocation-observer.h"
+#include "src/objects/allocation-site.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class Isolate;
+
+// Samples young generation allocations and attributes them to the
+// AllocationSite of the literal bytecode that is executing in the top
+// interpreted frame. After every GC the sampled objects are checked: objects
+// that were promoted count as survivors, objects that were collected count as
+// dead. Sites whose sampled survival rate reaches
+// AllocationSite::kPretenureRatio are switched to kTenure so that optimized
+// code allocates their objects directly in old space.
+//
+// Compared to the memento based feedback in Heap::ProcessPretenuringFeedback
+// this does not depend on mementos being found during a scavenge and does not
+// require the semi-space to be at maximum capacity.
+class V8_EXPORT_PRIVATE AllocationLifetimeProfiler final {
+ public:
+  // Minimum number of resolved samples before a site gets a decision.
+  static const int kMinResolvedSamples = 8;
+  // Upper bounds for the bookkeeping, so the profiler stays cheap on programs
+  // with many literal sites.
+  static const size_t kMaxTrackedSites = 1024;
+  static const size_t kMaxPendingSamples = 4096;
+
+  AllocationLifetimeProfiler(Heap* heap, intptr_t sample_interval);
+  ~AllocationLifetimeProfiler();
+  AllocationLifetimeProfiler(const AllocationLifetimeProfiler&) = delete;
+  AllocationLifetimeProfiler& operator=(const AllocationLifetimeProfiler&) =
+      delete;
+
+  AllocationObserver* observer() { return &observer_; }
+
+  // Resolves pending samples after a GC and updates the pretenuring decision
+  // of sites that have enough samples. Returns true if dependent code of at
+  // least one site was marked for deoptimization.
+  bool ProcessSamples();
+
+  // Records a sample for |site| directly. Exposed for testing.
+  void SampleObject(Address soon_object, AllocationSite site);
+
+  size_t pending_samples() const { return samples_.size(); }
+  size_t tracked_sites() const { return sites_.size(); }
+
+ private:
+  class Observer final : public AllocationObserver {
+   public:
+    Observer(AllocationLifetimeProfiler* profiler, intptr_t step_size)
+        : AllocationObserver(step_size), profiler_(profiler) {}
+
+    void Step(int bytes_allocated, Address soon_object, size_t size) override;
+
+   private:
+    AllocationLifetimeProfiler* const profiler_;
+  };
+
+  struct SiteProfile {
+    // Weak global handle to the AllocationSite. Cleared by the GC when the
+    // site dies.
+    Address* site = nullptr;
+    int survived = 0;
+    int died = 0;
+  };
+
+  struct Sample {
+    // Weak global handle to the sampled object. Cleared by the GC when the
+    // object dies.
+    Address* object = nullptr;
+    SiteProfile* site = nullptr;
+  };
+
+  // Returns the AllocationSite of the literal bytecode executing in the top
+  // interpreted frame, or an empty Object if there is none.
+  Object CurrentAllocationSite();
+  SiteProfile* FindOrAddSite(AllocationSite site);
+  bool MakePretenureDecision(SiteProfile* profile);
+
+  Isolate* const isolate_;
+  Observer observer_;
+  std::vector<std::unique_ptr<SiteProfile>> sites_;
+  std::vector<std::unique_ptr<Sample>> samples_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_ALLOCATION_LIFETIME_PROFILER_H_
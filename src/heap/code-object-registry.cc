@@ -12,6 +12,7 @@ namespace v8 {
 namespace internal {
 
 void CodeObjectRegistry::RegisterNewlyAllocatedCodeObject(Address code) {
+  base::MutexGuard guard(&code_object_registry_mutex_);
   if (is_sorted_) {
     is_sorted_ =
         (code_object_registry_.empty() || code_object_registry_.back() < code);
@@ -20,22 +21,34 @@ void CodeObjectRegistry::RegisterNewlyAllocatedCodeObject(Address code) {
 }
 
 void CodeObjectRegistry::RegisterAlreadyExistingCodeObject(Address code) {
+  base::MutexGuard guard(&code_object_registry_mutex_);
   DCHECK(is_sorted_);
   DCHECK(code_object_registry_.empty() || code_object_registry_.back() < code);
   code_object_registry_.push_back(code);
 }
 
 void CodeObjectRegistry::Clear() {
+  base::MutexGuard guard(&code_object_registry_mutex_);
   code_object_registry_.clear();
   is_sorted_ = true;
 }
 
 void CodeObjectRegistry::Finalize() {
+  base::MutexGuard guard(&code_object_registry_mutex_);
   DCHECK(is_sorted_);
   code_object_registry_.shrink_to_fit();
 }
 
+void CodeObjectRegistry::ReinitializeFrom(std::vector<Address>&& code_objects) {
+  DCHECK(std::is_sorted(code_objects.begin(), code_objects.end()));
+  code_objects.shrink_to_fit();
+  base::MutexGuard guard(&code_object_registry_mutex_);
+  code_object_registry_ = std::move(code_objects);
+  is_sorted_ = true;
+}
+
 bool CodeObjectRegistry::Contains(Address object) const {
+  base::MutexGuard guard(&code_object_registry_mutex_);
   if (!is_sorted_) {
     std::sort(code_object_registry_.begin(), code_object_registry_.end());
     is_sorted_ = true;
@@ -46,6 +59,7 @@ bool CodeObjectRegistry::Contains(Address object) const {
 
 Address CodeObjectRegistry::GetCodeObjectStartFromInnerAddress(
     Address address) const {
+  base::MutexGuard guard(&code_object_registry_mutex_);
   if (!is_sorted_) {
     std::sort(code_object_registry_.begin(), code_object_registry_.end());
     is_sorted_ = true;
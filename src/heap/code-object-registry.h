@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
 #include "src/common/globals.h"
 
 namespace v8 {
@@ -18,12 +19,19 @@ namespace internal {
 // MemoryChunk. Each MemoryChunk owns a separate CodeObjectRegistry. The
 // CodeObjectRegistry allows fast lookup from an inner pointer of a code object
 // to the actual code object.
+//
+// A code page may be swept on a background thread while the main thread looks
+// up code objects on it. All operations are therefore guarded by a mutex, and
+// sweeping publishes the new set of code objects at once via ReinitializeFrom.
 class V8_EXPORT_PRIVATE CodeObjectRegistry {
  public:
   void RegisterNewlyAllocatedCodeObject(Address code);
   void RegisterAlreadyExistingCodeObject(Address code);
   void Clear();
   void Finalize();
+  // Replaces the registered code objects with |code_objects|, which must be
+  // sorted.
+  void ReinitializeFrom(std::vector<Address>&& code_objects);
   bool Contains(Address code) const;
   Address GetCodeObjectStartFromInnerAddress(Address address) const;
 
@@ -32,6 +40,7 @@ class V8_EXPORT_PRIVATE CodeObjectRegistry {
   // that it can be lazily sorted during GetCodeObjectStartFromInnerAddress.
   mutable std::vector<Address> code_object_registry_;
   mutable bool is_sorted_ = true;
+  mutable base::Mutex code_object_registry_mutex_;
 };
 
 }  // namespace internal
@@ -12,6 +12,8 @@
 #include "src/heap/local-heap.h"
 #include "src/heap/marking.h"
 #include "src/heap/memory-chunk.h"
+#include "src/heap/new-spaces.h"
+#include "src/heap/paged-spaces.h"
 #include "src/heap/parked-scope.h"
 
 namespace v8 {
@@ -54,6 +56,16 @@ void StressConcurrentAllocatorTask::RunInternal() {
     heap->CreateFillerObjectAtBackground(
         address, kLargeObjectSize, ClearFreedMemoryMode::kDontClearFreedMemory);
     local_heap.Safepoint();
+
+    if (FLAG_concurrent_new_space_allocation) {
+      address = local_heap.AllocateRawOrFail(
+          kSmallObjectSize, AllocationType::kYoung, AllocationOrigin::kRuntime,
+          AllocationAlignment::kWordAligned);
+      heap->CreateFillerObjectAtBackground(
+          address, kSmallObjectSize,
+          ClearFreedMemoryMode::kDontClearFreedMemory);
+      local_heap.Safepoint();
+    }
   }
 
   Schedule(isolate_);
@@ -77,6 +89,13 @@ void ConcurrentAllocator::MakeLinearAllocationAreaIterable() {
 }
 
 void ConcurrentAllocator::MarkLinearAllocationAreaBlack() {
+  if (space_->identity() == NEW_SPACE) {
+    // Young objects are never allocated black and the marker only holds back
+    // objects in the main thread's LAB. Give up the LAB instead, it is not
+    // refilled until marking is done, see RawRefillLab.
+    FreeLinearAllocationArea();
+    return;
+  }
   Address top = lab_.top();
   Address limit = lab_.limit();
 
@@ -86,6 +105,10 @@ void ConcurrentAllocator::MarkLinearAllocationAreaBlack() {
 }
 
 void ConcurrentAllocator::UnmarkLinearAllocationArea() {
+  if (space_->identity() == NEW_SPACE) {
+    DCHECK(!lab_.IsValid());
+    return;
+  }
   Address top = lab_.top();
   Address limit = lab_.limit();
 
@@ -98,7 +121,7 @@ void ConcurrentAllocator::UnmarkLinearAllocationArea() {
 AllocationResult ConcurrentAllocator::AllocateInLabSlow(
     int object_size, AllocationAlignment alignment, AllocationOrigin origin) {
   if (!EnsureLab(origin)) {
-    return AllocationResult::Retry(OLD_SPACE);
+    return AllocationResult::Retry(space_->identity());
   }
 
   AllocationResult allocation = lab_.AllocateRawAligned(object_size, alignment);
@@ -108,12 +131,11 @@ AllocationResult ConcurrentAllocator::AllocateInLabSlow(
 }
 
 bool ConcurrentAllocator::EnsureLab(AllocationOrigin origin) {
-  auto result = space_->RawRefillLabBackground(
-      local_heap_, kLabSize, kMaxLabSize, kWordAligned, origin);
+  auto result = RawRefillLab(kLabSize, kMaxLabSize, kWordAligned, origin);
 
   if (!result) return false;
 
-  if (local_heap_->heap()->incremental_marking()->black_allocation()) {
+  if (IsBlackAllocationEnabled()) {
     Address top = result->first;
     Address limit = top + result->second;
     Page::FromAllocationAreaAddress(top)->CreateBlackAreaBackground(top, limit);
@@ -132,13 +154,12 @@ bool ConcurrentAllocator::EnsureLab(AllocationOrigin origin) {
 
 AllocationResult ConcurrentAllocator::AllocateOutsideLab(
     int object_size, AllocationAlignment alignment, AllocationOrigin origin) {
-  auto result = space_->RawRefillLabBackground(local_heap_, object_size,
-                                               object_size, alignment, origin);
-  if (!result) return AllocationResult::Retry(OLD_SPACE);
+  auto result = RawRefillLab(object_size, object_size, alignment, origin);
+  if (!result) return AllocationResult::Retry(space_->identity());
 
   HeapObject object = HeapObject::FromAddress(result->first);
 
-  if (local_heap_->heap()->incremental_marking()->black_allocation()) {
+  if (IsBlackAllocationEnabled()) {
     local_heap_->heap()->incremental_marking()->MarkBlackBackground(
         object, object_size);
   }
@@ -146,5 +167,26 @@ AllocationResult ConcurrentAllocator::AllocateOutsideLab(
   return AllocationResult(object);
 }
 
+base::Optional<std::pair<Address, size_t>> ConcurrentAllocator::RawRefillLab(
+    size_t min_size_in_bytes, size_t max_size_in_bytes,
+    AllocationAlignment alignment, AllocationOrigin origin) {
+  if (space_->identity() == NEW_SPACE) {
+    // While marking, young objects from background threads could be visited
+    // before they are initialized. Let the caller fall back to old space,
+    // where they are allocated black. Marking only starts in a safepoint, so
+    // it cannot start between this check and the end of the refill.
+    if (local_heap_->heap()->incremental_marking()->IsMarking()) return {};
+    return static_cast<NewSpace*>(space_)->RawRefillLabBackground(
+        min_size_in_bytes, max_size_in_bytes, alignment);
+  }
+  return static_cast<PagedSpace*>(space_)->RawRefillLabBackground(
+      local_heap_, min_size_in_bytes, max_size_in_bytes, alignment, origin);
+}
+
+bool ConcurrentAllocator::IsBlackAllocationEnabled() const {
+  return space_->identity() != NEW_SPACE &&
+         local_heap_->heap()->incremental_marking()->black_allocation();
+}
+
 }  // namespace internal
 }  // namespace v8
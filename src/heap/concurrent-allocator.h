@@ -5,6 +5,9 @@
 #ifndef V8_HEAP_CONCURRENT_ALLOCATOR_H_
 #define V8_HEAP_CONCURRENT_ALLOCATOR_H_
 
+#include <utility>
+
+#include "src/base/optional.h"
 #include "src/common/globals.h"
 #include "src/heap/heap.h"
 #include "src/heap/spaces.h"
@@ -30,17 +33,20 @@ class StressConcurrentAllocatorTask : public CancelableTask {
 };
 
 // Concurrent allocator for allocation from background threads/tasks.
-// Allocations are served from a TLAB if possible.
+// Allocations are served from a TLAB if possible. The allocator serves either
+// the old space or, with --concurrent-new-space-allocation, the new space.
 class ConcurrentAllocator {
  public:
   static const int kLabSize = 4 * KB;
   static const int kMaxLabSize = 32 * KB;
   static const int kMaxLabObjectSize = 2 * KB;
 
-  explicit ConcurrentAllocator(LocalHeap* local_heap, PagedSpace* space)
+  explicit ConcurrentAllocator(LocalHeap* local_heap, Space* space)
       : local_heap_(local_heap),
         space_(space),
-        lab_(LocalAllocationBuffer::InvalidBuffer()) {}
+        lab_(LocalAllocationBuffer::InvalidBuffer()) {
+    DCHECK(space->identity() == OLD_SPACE || space->identity() == NEW_SPACE);
+  }
 
   inline AllocationResult AllocateRaw(int object_size,
                                       AllocationAlignment alignment,
@@ -56,6 +62,14 @@ class ConcurrentAllocator {
       int object_size, AllocationAlignment alignment, AllocationOrigin origin);
   bool EnsureLab(AllocationOrigin origin);
 
+  base::Optional<std::pair<Address, size_t>> RawRefillLab(
+      size_t min_size_in_bytes, size_t max_size_in_bytes,
+      AllocationAlignment alignment, AllocationOrigin origin);
+
+  // Objects in new space are never allocated black. Instead, background threads
+  // don't get new space LABs while incremental marking is in progress.
+  bool IsBlackAllocationEnabled() const;
+
   inline AllocationResult AllocateInLab(int object_size,
                                         AllocationAlignment alignment,
                                         AllocationOrigin origin);
@@ -64,7 +78,7 @@ class ConcurrentAllocator {
       int object_size, AllocationAlignment alignment, AllocationOrigin origin);
 
   LocalHeap* const local_heap_;
-  PagedSpace* const space_;
+  Space* const space_;
   LocalAllocationBuffer lab_;
 };
 
@@ -448,6 +448,10 @@ void ConcurrentMarking::Run(JobDelegate* delegate,
       }
     }
     bool is_per_context_mode = local_marking_worklists.IsPerContextMode();
+    MarkingPrefetchQueue prefetch_queue(FLAG_marking_prefetch_distance);
+    auto pop = [&local_marking_worklists](HeapObject* object) {
+      return local_marking_worklists.Pop(object);
+    };
     bool done = false;
     while (!done) {
       size_t current_marked_bytes = 0;
@@ -455,7 +459,7 @@ void ConcurrentMarking::Run(JobDelegate* delegate,
       while (current_marked_bytes < kBytesUntilInterruptCheck &&
              objects_processed < kObjectsUntilInterrupCheck) {
         HeapObject object;
-        if (!local_marking_worklists.Pop(&object)) {
+        if (!prefetch_queue.Pop(pop, &object)) {
           done = true;
           break;
         }
@@ -504,6 +508,11 @@ void ConcurrentMarking::Run(JobDelegate* delegate,
       }
     }
 
+    // Objects that were prefetched but not visited go back to the worklist
+    // so that other markers can pick them up.
+    prefetch_queue.Flush([&local_marking_worklists](HeapObject object) {
+      local_marking_worklists.Push(object);
+    });
     local_marking_worklists.Publish();
     weak_objects_->transition_arrays.FlushToGlobal(task_id);
     weak_objects_->ephemeron_hash_tables.FlushToGlobal(task_id);
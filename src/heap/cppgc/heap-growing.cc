@@ -45,6 +45,7 @@ class HeapGrowing::HeapGrowingImpl final
 
   size_t limit_for_atomic_gc() const { return limit_for_atomic_gc_; }
   size_t limit_for_incremental_gc() const { return limit_for_incremental_gc_; }
+  size_t limit_for_minor_gc() const { return limit_for_minor_gc_; }
 
   void DisableForTesting();
 
@@ -57,6 +58,7 @@ class HeapGrowing::HeapGrowingImpl final
   size_t initial_heap_size_ = 1 * kMB;
   size_t limit_for_atomic_gc_ = 0;       // See ConfigureLimit().
   size_t limit_for_incremental_gc_ = 0;  // See ConfigureLimit().
+  size_t limit_for_minor_gc_ = 0;        // See ConfigureLimit().
 
   SingleThreadedHandle gc_task_handle_;
 
@@ -96,12 +98,21 @@ void HeapGrowing::HeapGrowingImpl::AllocatedObjectSizeIncreased(size_t) {
         {GarbageCollector::Config::CollectionType::kMajor,
          GarbageCollector::Config::StackState::kMayContainHeapPointers,
          GarbageCollector::Config::MarkingType::kAtomic, sweeping_support_});
-  } else if (allocated_object_size > limit_for_incremental_gc_) {
-    if (marking_support_ == cppgc::Heap::MarkingType::kAtomic) return;
+  } else if (allocated_object_size > limit_for_incremental_gc_ &&
+             marking_support_ != cppgc::Heap::MarkingType::kAtomic) {
     collector_->StartIncrementalGarbageCollection(
         {GarbageCollector::Config::CollectionType::kMajor,
          GarbageCollector::Config::StackState::kMayContainHeapPointers,
          marking_support_, sweeping_support_});
+#if defined(CPPGC_YOUNG_GENERATION)
+  } else if (allocated_object_size > limit_for_minor_gc_) {
+    // Minor GCs cannot scan the stack. GCInvoker postpones them to a
+    // non-nestable task.
+    collector_->CollectGarbage(
+        {GarbageCollector::Config::CollectionType::kMinor,
+         GarbageCollector::Config::StackState::kMayContainHeapPointers,
+         GarbageCollector::Config::MarkingType::kAtomic, sweeping_support_});
+#endif  // defined(CPPGC_YOUNG_GENERATION)
   }
 }
 
@@ -112,6 +123,9 @@ void HeapGrowing::HeapGrowingImpl::ResetAllocatedObjectSize(
 
 void HeapGrowing::HeapGrowingImpl::ConfigureLimit(
     size_t allocated_object_size) {
+  // Objects that survived the last GC are old because of sticky mark bits,
+  // so everything allocated from now on is young.
+  limit_for_minor_gc_ = allocated_object_size + kYoungGenerationSize;
   const size_t size = std::max(allocated_object_size, initial_heap_size_);
   limit_for_atomic_gc_ = std::max(static_cast<size_t>(size * kGrowingFactor),
                                   size + kMinLimitIncrease);
@@ -161,11 +175,16 @@ size_t HeapGrowing::limit_for_atomic_gc() const {
 size_t HeapGrowing::limit_for_incremental_gc() const {
   return impl_->limit_for_incremental_gc();
 }
+size_t HeapGrowing::limit_for_minor_gc() const {
+  return impl_->limit_for_minor_gc();
+}
 
 void HeapGrowing::DisableForTesting() { impl_->DisableForTesting(); }
 
 // static
 constexpr double HeapGrowing::kGrowingFactor;
+// static
+constexpr size_t HeapGrowing::kYoungGenerationSize;
 
 }  // namespace internal
 }  // namespace cppgc
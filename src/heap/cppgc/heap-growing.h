@@ -32,6 +32,9 @@ class V8_EXPORT_PRIVATE HeapGrowing final {
   // before triggering GC again.
   static constexpr size_t kMinLimitIncrease =
       kPageSize * RawHeap::kNumberOfRegularSpaces;
+  // Bytes that can be allocated after a GC before a minor GC is triggered.
+  // Only used with CPPGC_YOUNG_GENERATION.
+  static constexpr size_t kYoungGenerationSize = 4 * kMB;
 
   HeapGrowing(GarbageCollector*, StatsCollector*,
               cppgc::Heap::ResourceConstraints, cppgc::Heap::MarkingType,
@@ -43,6 +46,7 @@ class V8_EXPORT_PRIVATE HeapGrowing final {
 
   size_t limit_for_atomic_gc() const;
   size_t limit_for_incremental_gc() const;
+  size_t limit_for_minor_gc() const;
 
   void DisableForTesting();
 
@@ -8,7 +8,6 @@
 #include "src/heap/cppgc/garbage-collector.h"
 #include "src/heap/cppgc/gc-invoker.h"
 #include "src/heap/cppgc/heap-object-header.h"
-#include "src/heap/cppgc/heap-visitor.h"
 #include "src/heap/cppgc/marker.h"
 #include "src/heap/cppgc/marking-verifier.h"
 #include "src/heap/cppgc/prefinalizer-handler.h"
@@ -57,19 +56,6 @@ namespace internal {
 
 namespace {
 
-class Unmarker final : private HeapVisitor<Unmarker> {
-  friend class HeapVisitor<Unmarker>;
-
- public:
-  explicit Unmarker(RawHeap* heap) { Traverse(heap); }
-
- private:
-  bool VisitHeapObjectHeader(HeapObjectHeader* header) {
-    if (header->IsMarked()) header->Unmark();
-    return true;
-  }
-};
-
 void CheckConfig(Heap::Config config, Heap::MarkingType marking_support,
                  Heap::SweepingType sweeping_support) {
   CHECK_WITH_MSG(
@@ -92,7 +78,11 @@ Heap::Heap(std::shared_ptr<cppgc::Platform> platform,
                options.resource_constraints, options.marking_support,
                options.sweeping_support),
       marking_support_(options.marking_support),
-      sweeping_support_(options.sweeping_support) {
+      sweeping_support_(options.sweeping_support),
+      supports_attached_threads_(options.supports_attached_threads) {
+  // Attached threads allocate and free pages concurrently to lookups on this
+  // thread. Heaps without them can look up pages without locking.
+  if (supports_attached_threads_) page_backend_->EnableConcurrentMutation();
   CHECK_IMPLIES(options.marking_support != MarkingType::kAtomic,
                 platform_->GetForegroundTaskRunner());
   CHECK_IMPLIES(options.sweeping_support != SweepingType::kAtomic,
@@ -109,12 +99,25 @@ bool Heap::IsMarking() const { return marker_.get(); }
 
 void Heap::CollectGarbage(Config config) {
   DCHECK_EQ(Config::MarkingType::kAtomic, config.marking_type);
+  // Minor GCs cannot scan the stack, see VisitRememberedSlots().
+  DCHECK_IMPLIES(config.collection_type == Config::CollectionType::kMinor,
+                 config.stack_state == Config::StackState::kNoHeapPointers);
   CheckConfig(config, marking_support_, sweeping_support_);
 
   if (in_no_gc_scope()) return;
 
+  // A minor GC must not finalize a running major GC.
+  if ((config.collection_type == Config::CollectionType::kMinor) &&
+      IsMarking()) {
+    return;
+  }
+
   config_ = config;
 
+  // Attached threads are parked for the whole garbage collection as they may
+  // not allocate while the heap is marked or swept atomically.
+  Safepoint::StopTheWorldScope stop_the_world(safepoint_);
+
   if (!IsMarking()) StartGarbageCollection(config);
 
   DCHECK(IsMarking());
@@ -157,11 +160,6 @@ void Heap::StartGarbageCollection(Config config) {
 
   epoch_++;
 
-#if defined(CPPGC_YOUNG_GENERATION)
-  if (config.collection_type == Config::CollectionType::kMajor)
-    Unmarker unmarker(&raw_heap());
-#endif
-
   const Marker::MarkingConfig marking_config{
       config.collection_type, config.stack_state, config.marking_type,
       config.is_forced_gc};
@@ -12,6 +12,7 @@
 #include "src/heap/cppgc/gc-invoker.h"
 #include "src/heap/cppgc/heap-base.h"
 #include "src/heap/cppgc/heap-growing.h"
+#include "src/heap/cppgc/safepoint.h"
 
 namespace cppgc {
 namespace internal {
@@ -38,6 +39,13 @@ class V8_EXPORT_PRIVATE Heap final : public HeapBase,
 
   size_t epoch() const final { return epoch_; }
 
+  MarkingType marking_support() const { return marking_support_; }
+  bool supports_attached_threads() const { return supports_attached_threads_; }
+
+  // Coordinates garbage collections with threads attached through
+  // cppgc::subtle::MutatorThreadScope.
+  Safepoint& safepoint() { return safepoint_; }
+
   void DisableHeapGrowingForTesting();
 
  private:
@@ -56,6 +64,9 @@ class V8_EXPORT_PRIVATE Heap final : public HeapBase,
 
   const MarkingType marking_support_;
   const SweepingType sweeping_support_;
+  const bool supports_attached_threads_;
+
+  Safepoint safepoint_;
 
   size_t epoch_ = 0;
 };
@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "include/cppgc/internal/pointer-policies.h"
 #include "include/cppgc/internal/process-heap.h"
 #include "include/cppgc/platform.h"
 #include "src/heap/cppgc/heap-object-header.h"
@@ -72,11 +73,28 @@ void VisitRememberedSlots(HeapBase& heap,
     DCHECK(!slot_header.template IsInConstruction<AccessMode::kNonAtomic>());
 
     void* value = *reinterpret_cast<void**>(slot);
+    // The slot may have been cleared after it was recorded.
+    if (!value || value == kSentinelPointer) continue;
     mutator_marking_state.DynamicallyMarkAddress(static_cast<Address>(value));
   }
 #endif
 }
 
+#if defined(CPPGC_YOUNG_GENERATION)
+class Unmarker final : private HeapVisitor<Unmarker> {
+  friend class HeapVisitor<Unmarker>;
+
+ public:
+  explicit Unmarker(RawHeap* heap) { Traverse(heap); }
+
+ private:
+  bool VisitHeapObjectHeader(HeapObjectHeader* header) {
+    if (header->IsMarked()) header->Unmark();
+    return true;
+  }
+};
+#endif  // defined(CPPGC_YOUNG_GENERATION)
+
 // Assumes that all spaces have their LABs reset.
 void ResetRememberedSet(HeapBase& heap) {
 #if defined(CPPGC_YOUNG_GENERATION)
@@ -208,6 +226,14 @@ void MarkerBase::StartMarking() {
   heap().stats_collector()->NotifyMarkingStarted(config_.collection_type,
                                                  config_.is_forced_gc);
 
+#if defined(CPPGC_YOUNG_GENERATION)
+  if (config_.collection_type == MarkingConfig::CollectionType::kMajor) {
+    // Young generation uses sticky mark bits, which have to be cleared before
+    // a major GC.
+    Unmarker unmarker(&heap().raw_heap());
+  }
+#endif
+
   is_marking_started_ = true;
   if (EnterIncrementalMarkingIfNeeded(config_, heap())) {
     StatsCollector::EnabledScope stats_scope(
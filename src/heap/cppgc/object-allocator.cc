@@ -15,6 +15,7 @@
 #include "src/heap/cppgc/heap.h"
 #include "src/heap/cppgc/object-start-bitmap.h"
 #include "src/heap/cppgc/page-memory.h"
+#include "src/heap/cppgc/sanitizers.h"
 #include "src/heap/cppgc/stats-collector.h"
 #include "src/heap/cppgc/sweeper.h"
 
@@ -84,20 +85,29 @@ void ReplaceLinearAllocationBuffer(NormalPageSpace* space,
 }
 
 void* AllocateLargeObject(PageBackend* page_backend, LargePageSpace* space,
-                          StatsCollector* stats_collector, size_t size,
-                          GCInfoIndex gcinfo) {
+                          size_t size, GCInfoIndex gcinfo) {
   LargePage* page = LargePage::Create(page_backend, space, size);
   space->AddPage(page);
 
   auto* header = new (page->ObjectHeader())
       HeapObjectHeader(HeapObjectHeader::kLargeObjectSizeInHeader, gcinfo);
 
-  stats_collector->NotifyAllocation(size);
   MarkRangeAsYoung(page, page->PayloadStart(), page->PayloadEnd());
 
   return header->Payload();
 }
 
+// Formats the unused part of a linear allocation buffer of an attached thread
+// as free memory. The block is added to the free list of the space when the
+// page is swept.
+void ReleaseToSweeper(Address start, size_t size) {
+  ASAN_UNPOISON_MEMORY_REGION(start, sizeof(HeapObjectHeader));
+  new (start) HeapObjectHeader(size, kFreeListGCInfoIndex);
+  NormalPage::From(BasePage::FromPayload(start))
+      ->object_start_bitmap()
+      .SetBit(start);
+}
+
 }  // namespace
 
 ObjectAllocator::ObjectAllocator(RawHeap* heap, PageBackend* page_backend,
@@ -106,8 +116,21 @@ ObjectAllocator::ObjectAllocator(RawHeap* heap, PageBackend* page_backend,
       page_backend_(page_backend),
       stats_collector_(stats_collector) {}
 
+ObjectAllocator::ObjectAllocator(RawHeap* heap, PageBackend* page_backend,
+                                 StatsCollector* stats_collector,
+                                 AttachedThread)
+    : raw_heap_(heap),
+      page_backend_(page_backend),
+      stats_collector_(stats_collector),
+      attached_thread_labs_(heap->size()) {
+  DCHECK(is_attached_thread());
+}
+
 void* ObjectAllocator::OutOfLineAllocate(NormalPageSpace* space, size_t size,
                                          GCInfoIndex gcinfo) {
+  if (is_attached_thread()) {
+    return OutOfLineAllocateOnAttachedThread(space, size, gcinfo);
+  }
   void* memory = OutOfLineAllocateImpl(space, size, gcinfo);
   stats_collector_->NotifySafePointForConservativeCollection();
   raw_heap_->heap()->AdvanceIncrementalGarbageCollectionOnAllocationIfNeeded();
@@ -123,8 +146,10 @@ void* ObjectAllocator::OutOfLineAllocateImpl(NormalPageSpace* space,
   if (size >= kLargeObjectSizeThreshold) {
     auto* large_space = LargePageSpace::From(
         raw_heap_->Space(RawHeap::RegularSpaceType::kLarge));
-    return AllocateLargeObject(page_backend_, large_space, stats_collector_,
-                               size, gcinfo);
+    void* result =
+        AllocateLargeObject(page_backend_, large_space, size, gcinfo);
+    stats_collector_->NotifyAllocation(size);
+    return result;
   }
 
   // 2. Try to allocate from the freelist.
@@ -170,7 +195,51 @@ void* ObjectAllocator::AllocateFromFreeList(NormalPageSpace* space, size_t size,
   return AllocateObjectOnSpace(space, size, gcinfo);
 }
 
+void* ObjectAllocator::OutOfLineAllocateOnAttachedThread(
+    NormalPageSpace* space, size_t size, GCInfoIndex gcinfo) {
+  DCHECK(is_attached_thread());
+  DCHECK_EQ(0, size & kAllocationMask);
+  DCHECK_LE(kFreeListEntrySize, size);
+
+  if (size >= kLargeObjectSizeThreshold) {
+    auto* large_space = LargePageSpace::From(
+        raw_heap_->Space(RawHeap::RegularSpaceType::kLarge));
+    void* result =
+        AllocateLargeObject(page_backend_, large_space, size, gcinfo);
+    stats_collector_->NotifyAllocationOnAttachedThread(size);
+    return result;
+  }
+
+  // Pages are private to the thread until its buffer on them is released, so
+  // the new page is added to the space right away.
+  auto* new_page = NormalPage::Create(page_backend_, space);
+  space->AddPage(new_page);
+
+  auto& lab = attached_thread_labs_[space->index()];
+  if (lab.size()) {
+    ReleaseToSweeper(lab.start(), lab.size());
+    stats_collector_->NotifyExplicitFreeOnAttachedThread(lab.size());
+  }
+  lab.Set(new_page->PayloadStart(), new_page->PayloadSize());
+  stats_collector_->NotifyAllocationOnAttachedThread(new_page->PayloadSize());
+
+  void* result = AllocateObjectOnSpace(space, size, gcinfo);
+  CHECK(result);
+
+  return result;
+}
+
 void ObjectAllocator::ResetLinearAllocationBuffers() {
+  if (is_attached_thread()) {
+    for (auto& lab : attached_thread_labs_) {
+      if (!lab.size()) continue;
+      ReleaseToSweeper(lab.start(), lab.size());
+      stats_collector_->NotifyExplicitFreeOnAttachedThread(lab.size());
+      lab.Set(nullptr, 0);
+    }
+    return;
+  }
+
   class Resetter : public HeapVisitor<Resetter> {
    public:
     explicit Resetter(StatsCollector* stats) : stats_collector_(stats) {}
@@ -5,6 +5,8 @@
 #ifndef V8_HEAP_CPPGC_OBJECT_ALLOCATOR_H_
 #define V8_HEAP_CPPGC_OBJECT_ALLOCATOR_H_
 
+#include <vector>
+
 #include "include/cppgc/allocation.h"
 #include "include/cppgc/internal/gc-info.h"
 #include "include/cppgc/macros.h"
@@ -47,8 +49,18 @@ class V8_EXPORT_PRIVATE ObjectAllocator final : public cppgc::AllocationHandle {
     ObjectAllocator& allocator_;
   };
 
+  // Tag for allocators of threads attached through
+  // cppgc::subtle::MutatorThreadScope.
+  struct AttachedThread {};
+
   ObjectAllocator(RawHeap* heap, PageBackend* page_backend,
                   StatsCollector* stats_collector);
+  // Creates an allocator for an attached thread. Such allocators own their
+  // linear allocation buffers which are refilled from fresh pages only, as the
+  // free lists are owned by the thread owning the heap and the sweeper.
+  // Allocations on attached threads never trigger garbage collections.
+  ObjectAllocator(RawHeap* heap, PageBackend* page_backend,
+                  StatsCollector* stats_collector, AttachedThread);
 
   inline void* AllocateObject(size_t size, GCInfoIndex gcinfo);
   inline void* AllocateObject(size_t size, GCInfoIndex gcinfo,
@@ -63,17 +75,27 @@ class V8_EXPORT_PRIVATE ObjectAllocator final : public cppgc::AllocationHandle {
       size_t size);
 
   bool is_allocation_allowed() const { return no_allocation_scope_ == 0; }
+  bool is_attached_thread() const { return !attached_thread_labs_.empty(); }
+
+  inline NormalPageSpace::LinearAllocationBuffer& GetLinearAllocationBuffer(
+      NormalPageSpace* space);
 
   inline void* AllocateObjectOnSpace(NormalPageSpace* space, size_t size,
                                      GCInfoIndex gcinfo);
   void* OutOfLineAllocate(NormalPageSpace*, size_t, GCInfoIndex);
   void* OutOfLineAllocateImpl(NormalPageSpace*, size_t, GCInfoIndex);
   void* AllocateFromFreeList(NormalPageSpace*, size_t, GCInfoIndex);
+  void* OutOfLineAllocateOnAttachedThread(NormalPageSpace*, size_t,
+                                          GCInfoIndex);
 
   RawHeap* raw_heap_;
   PageBackend* page_backend_;
   StatsCollector* stats_collector_;
   size_t no_allocation_scope_ = 0;
+  // Buffers indexed by space for allocators of attached threads. Empty for the
+  // allocator of the thread owning the heap, which uses the buffers of the
+  // spaces.
+  std::vector<NormalPageSpace::LinearAllocationBuffer> attached_thread_labs_;
 };
 
 void* ObjectAllocator::AllocateObject(size_t size, GCInfoIndex gcinfo) {
@@ -107,12 +129,20 @@ RawHeap::RegularSpaceType ObjectAllocator::GetInitialSpaceIndexForSize(
   return RawHeap::RegularSpaceType::kNormal4;
 }
 
+NormalPageSpace::LinearAllocationBuffer&
+ObjectAllocator::GetLinearAllocationBuffer(NormalPageSpace* space) {
+  if (V8_LIKELY(!is_attached_thread())) {
+    return space->linear_allocation_buffer();
+  }
+  return attached_thread_labs_[space->index()];
+}
+
 void* ObjectAllocator::AllocateObjectOnSpace(NormalPageSpace* space,
                                              size_t size, GCInfoIndex gcinfo) {
   DCHECK_LT(0u, gcinfo);
 
   NormalPageSpace::LinearAllocationBuffer& current_lab =
-      space->linear_allocation_buffer();
+      GetLinearAllocationBuffer(space);
   if (current_lab.size() < size) {
     return OutOfLineAllocate(space, size, gcinfo);
   }
@@ -170,6 +170,7 @@ PageBackend::PageBackend(PageAllocator* allocator) : allocator_(allocator) {}
 PageBackend::~PageBackend() = default;
 
 Address PageBackend::AllocateNormalPageMemory(size_t bucket) {
+  v8::base::MutexGuard guard(&mutex_);
   std::pair<NormalPageMemoryRegion*, Address> result = page_pool_.Take(bucket);
   if (!result.first) {
     auto pmr = std::make_unique<NormalPageMemoryRegion>(allocator_);
@@ -179,13 +180,15 @@ Address PageBackend::AllocateNormalPageMemory(size_t bucket) {
     }
     page_memory_region_tree_.Add(pmr.get());
     normal_page_memory_regions_.push_back(std::move(pmr));
-    return AllocateNormalPageMemory(bucket);
+    result = page_pool_.Take(bucket);
+    DCHECK(result.first);
   }
   result.first->Allocate(result.second);
   return result.second;
 }
 
 void PageBackend::FreeNormalPageMemory(size_t bucket, Address writeable_base) {
+  v8::base::MutexGuard guard(&mutex_);
   auto* pmr = static_cast<NormalPageMemoryRegion*>(
       page_memory_region_tree_.Lookup(writeable_base));
   pmr->Free(writeable_base);
@@ -193,6 +196,7 @@ void PageBackend::FreeNormalPageMemory(size_t bucket, Address writeable_base) {
 }
 
 Address PageBackend::AllocateLargePageMemory(size_t size) {
+  v8::base::MutexGuard guard(&mutex_);
   auto pmr = std::make_unique<LargePageMemoryRegion>(allocator_, size);
   const PageMemory pm = pmr->GetPageMemory();
   Unprotect(allocator_, pm);
@@ -202,6 +206,7 @@ Address PageBackend::AllocateLargePageMemory(size_t size) {
 }
 
 void PageBackend::FreeLargePageMemory(Address writeable_base) {
+  v8::base::MutexGuard guard(&mutex_);
   PageMemoryRegion* pmr = page_memory_region_tree_.Lookup(writeable_base);
   page_memory_region_tree_.Remove(pmr);
   auto size = large_page_memory_regions_.erase(pmr);
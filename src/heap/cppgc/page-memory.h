@@ -13,6 +13,8 @@
 
 #include "include/cppgc/platform.h"
 #include "src/base/macros.h"
+#include "src/base/optional.h"
+#include "src/base/platform/mutex.h"
 #include "src/heap/cppgc/globals.h"
 
 namespace cppgc {
@@ -190,7 +192,10 @@ class V8_EXPORT_PRIVATE NormalPageMemoryPool final {
 // A backend that is used for allocating and freeing normal and large pages.
 //
 // Internally maintaints a set of PageMemoryRegions. The backend keeps its used
-// regions alive.
+// regions alive. Allocating and freeing pages is thread-safe as threads
+// attached to the heap allocate pages concurrently with the thread owning it.
+// Lookups only synchronize with them once EnableConcurrentMutation() was
+// called, which keeps conservative stack scanning cheap for other heaps.
 class V8_EXPORT_PRIVATE PageBackend final {
  public:
   explicit PageBackend(PageAllocator*);
@@ -218,11 +223,19 @@ class V8_EXPORT_PRIVATE PageBackend final {
   // memory.
   inline Address Lookup(ConstAddress) const;
 
+  // Makes Lookup() safe against concurrent allocation and freeing of pages.
+  // Must be called before pages are allocated or freed on other threads.
+  void EnableConcurrentMutation() { concurrent_mutation_ = true; }
+
   // Disallow copy/move.
   PageBackend(const PageBackend&) = delete;
   PageBackend& operator=(const PageBackend&) = delete;
 
  private:
+  // Only set before other threads may use the backend.
+  bool concurrent_mutation_ = false;
+  // Guards all members below.
+  mutable v8::base::Mutex mutex_;
   PageAllocator* allocator_;
   NormalPageMemoryPool page_pool_;
   PageMemoryRegionTree page_memory_region_tree_;
@@ -268,6 +281,8 @@ PageMemoryRegion* PageMemoryRegionTree::Lookup(ConstAddress address) const {
 }
 
 Address PageBackend::Lookup(ConstAddress address) const {
+  v8::base::Optional<v8::base::MutexGuard> guard;
+  if (concurrent_mutation_) guard.emplace(&mutex_);
   PageMemoryRegion* pmr = page_memory_region_tree_.Lookup(address);
   return pmr ? pmr->Lookup(address) : nullptr;
 }
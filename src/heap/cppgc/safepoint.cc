@@ -0,0 +1,136 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/cppgc/safepoint.h"
+
+#include <algorithm>
+
+#include "include/cppgc/heap.h"
+#include "include/cppgc/mutator-thread-scope.h"
+#include "src/base/logging.h"
+#include "src/heap/cppgc/heap.h"
+#include "src/heap/cppgc/object-allocator.h"
+
+namespace cppgc {
+namespace internal {
+
+Safepoint::~Safepoint() {
+  CHECK_WITH_MSG(allocators_.empty(),
+                 "Threads must be detached before the heap is destroyed");
+}
+
+void Safepoint::Attach(ObjectAllocator* allocator) {
+  v8::base::MutexGuard guard(&mutex_);
+  WaitWhileStoppedLocked();
+  DCHECK_EQ(allocators_.end(),
+            std::find(allocators_.begin(), allocators_.end(), allocator));
+  allocators_.push_back(allocator);
+  running_threads_++;
+}
+
+void Safepoint::Detach(ObjectAllocator* allocator) {
+  v8::base::MutexGuard guard(&mutex_);
+  auto it = std::find(allocators_.begin(), allocators_.end(), allocator);
+  DCHECK_NE(allocators_.end(), it);
+  allocators_.erase(it);
+  DCHECK_LT(0u, running_threads_);
+  running_threads_--;
+  cv_.NotifyAll();
+}
+
+void Safepoint::Park() {
+  v8::base::MutexGuard guard(&mutex_);
+  DCHECK_LT(0u, running_threads_);
+  running_threads_--;
+  cv_.NotifyAll();
+}
+
+void Safepoint::Unpark() {
+  v8::base::MutexGuard guard(&mutex_);
+  WaitWhileStoppedLocked();
+  running_threads_++;
+  DCHECK_GE(allocators_.size(), running_threads_);
+}
+
+size_t Safepoint::attached_threads() const {
+  v8::base::MutexGuard guard(&mutex_);
+  return allocators_.size();
+}
+
+void Safepoint::StopTheWorld() {
+  v8::base::MutexGuard guard(&mutex_);
+  DCHECK(!stop_requested_.load(std::memory_order_relaxed));
+  stop_requested_.store(true, std::memory_order_relaxed);
+  while (running_threads_ > 0) cv_.Wait(&mutex_);
+  // Parked threads do not touch the heap until the world is resumed, which
+  // makes it safe to give back their buffers from this thread.
+  for (ObjectAllocator* allocator : allocators_) {
+    allocator->ResetLinearAllocationBuffers();
+  }
+}
+
+void Safepoint::ResumeTheWorld() {
+  v8::base::MutexGuard guard(&mutex_);
+  DCHECK(stop_requested_.load(std::memory_order_relaxed));
+  stop_requested_.store(false, std::memory_order_relaxed);
+  cv_.NotifyAll();
+}
+
+void Safepoint::WaitWhileStoppedLocked() {
+  while (stop_requested_.load(std::memory_order_relaxed)) cv_.Wait(&mutex_);
+}
+
+}  // namespace internal
+
+namespace subtle {
+
+MutatorThreadScope::MutatorThreadScope(cppgc::Heap* heap)
+    : heap_(internal::Heap::From(heap)),
+      allocator_(std::make_unique<internal::ObjectAllocator>(
+          &heap_->raw_heap(), heap_->page_backend(), heap_->stats_collector(),
+          internal::ObjectAllocator::AttachedThread{})) {
+#if defined(CPPGC_YOUNG_GENERATION)
+  // Objects allocated on attached threads would require generational barriers
+  // from those threads.
+  CHECK_WITH_MSG(false, "Attached threads require a heap without young "
+                        "generation");
+#endif  // defined(CPPGC_YOUNG_GENERATION)
+  CHECK_WITH_MSG(heap_->supports_attached_threads(),
+                 "Attached threads require a heap created with "
+                 "HeapOptions::supports_attached_threads");
+  // Incremental and concurrent marking would require attached threads to
+  // execute write barriers and to be scanned when marking finishes.
+  CHECK_WITH_MSG(cppgc::Heap::MarkingType::kAtomic == heap_->marking_support(),
+                 "Attached threads require a heap with atomic marking");
+  heap_->safepoint().Attach(allocator_.get());
+}
+
+MutatorThreadScope::~MutatorThreadScope() {
+  allocator_->ResetLinearAllocationBuffers();
+  heap_->safepoint().Detach(allocator_.get());
+}
+
+AllocationHandle& MutatorThreadScope::GetAllocationHandle() {
+  return *allocator_;
+}
+
+void MutatorThreadScope::Safepoint() {
+  if (V8_LIKELY(!heap_->safepoint().IsStopRequested())) return;
+  Park();
+  Unpark();
+}
+
+void MutatorThreadScope::Park() { heap_->safepoint().Park(); }
+
+void MutatorThreadScope::Unpark() { heap_->safepoint().Unpark(); }
+
+MutatorThreadScope::ParkedScope::ParkedScope(MutatorThreadScope& scope)
+    : scope_(scope) {
+  scope_.Park();
+}
+
+MutatorThreadScope::ParkedScope::~ParkedScope() { scope_.Unpark(); }
+
+}  // namespace subtle
+}  // namespace cppgc
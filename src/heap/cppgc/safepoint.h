@@ -0,0 +1,82 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CPPGC_SAFEPOINT_H_
+#define V8_HEAP_CPPGC_SAFEPOINT_H_
+
+#include <atomic>
+#include <vector>
+
+#include "src/base/macros.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+
+namespace cppgc {
+namespace internal {
+
+class ObjectAllocator;
+
+// Coordinates the thread owning a heap with the threads attached through
+// cppgc::subtle::MutatorThreadScope. Attached threads are either running or
+// parked. Stopping the world waits until all attached threads are parked and
+// then releases their linear allocation buffers, so that the heap is iterable
+// during the garbage collection. Attached threads that try to unpark block
+// until the world is resumed.
+class V8_EXPORT_PRIVATE Safepoint final {
+ public:
+  class V8_NODISCARD StopTheWorldScope final {
+   public:
+    explicit StopTheWorldScope(Safepoint& safepoint) : safepoint_(safepoint) {
+      safepoint_.StopTheWorld();
+    }
+    ~StopTheWorldScope() { safepoint_.ResumeTheWorld(); }
+
+    StopTheWorldScope(const StopTheWorldScope&) = delete;
+    StopTheWorldScope& operator=(const StopTheWorldScope&) = delete;
+
+   private:
+    Safepoint& safepoint_;
+  };
+
+  Safepoint() = default;
+  ~Safepoint();
+
+  Safepoint(const Safepoint&) = delete;
+  Safepoint& operator=(const Safepoint&) = delete;
+
+  // Registers the allocator of an attached thread. The thread is running
+  // afterwards.
+  void Attach(ObjectAllocator*);
+  // Unregisters the allocator of a running attached thread.
+  void Detach(ObjectAllocator*);
+
+  void Park();
+  void Unpark();
+
+  // Returns whether the thread owning the heap waits for attached threads to
+  // park. Only a hint for attached threads to avoid taking the lock.
+  bool IsStopRequested() const {
+    return stop_requested_.load(std::memory_order_relaxed);
+  }
+
+  size_t attached_threads() const;
+
+ private:
+  void StopTheWorld();
+  void ResumeTheWorld();
+
+  // Waits until the world is resumed. Must be called with |mutex_| held.
+  void WaitWhileStoppedLocked();
+
+  mutable v8::base::Mutex mutex_;
+  v8::base::ConditionVariable cv_;
+  std::vector<ObjectAllocator*> allocators_;
+  size_t running_threads_ = 0;
+  std::atomic<bool> stop_requested_{false};
+};
+
+}  // namespace internal
+}  // namespace cppgc
+
+#endif  // V8_HEAP_CPPGC_SAFEPOINT_H_
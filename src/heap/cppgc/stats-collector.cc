@@ -40,7 +40,26 @@ void StatsCollector::NotifyExplicitFree(size_t bytes) {
   explicitly_freed_bytes_since_safepoint_ += bytes;
 }
 
+void StatsCollector::NotifyAllocationOnAttachedThread(size_t bytes) {
+  attached_threads_bytes_since_safepoint_.fetch_add(
+      static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void StatsCollector::NotifyExplicitFreeOnAttachedThread(size_t bytes) {
+  attached_threads_bytes_since_safepoint_.fetch_sub(
+      static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
 void StatsCollector::NotifySafePointForConservativeCollection() {
+  if (attached_threads_bytes_since_safepoint_.load(std::memory_order_relaxed)) {
+    const int64_t delta = attached_threads_bytes_since_safepoint_.exchange(
+        0, std::memory_order_relaxed);
+    if (delta < 0) {
+      explicitly_freed_bytes_since_safepoint_ -= delta;
+    } else {
+      allocated_bytes_since_safepoint_ += delta;
+    }
+  }
   if (std::abs(allocated_bytes_since_safepoint_ -
                explicitly_freed_bytes_since_safepoint_) >=
       static_cast<int64_t>(kAllocationThresholdBytes)) {
@@ -87,9 +106,17 @@ void StatsCollector::NotifyMarkingStarted(CollectionType collection_type,
 void StatsCollector::NotifyMarkingCompleted(size_t marked_bytes) {
   DCHECK_EQ(GarbageCollectionState::kMarking, gc_state_);
   gc_state_ = GarbageCollectionState::kSweeping;
+  if (current_.collection_type == CollectionType::kMinor) {
+    // Minor GCs only mark young objects. Objects that survived the previous
+    // GC are old and retained until the next major GC.
+    marked_bytes += previous_.marked_bytes;
+  }
   current_.marked_bytes = marked_bytes;
   allocated_bytes_since_safepoint_ = 0;
   explicitly_freed_bytes_since_safepoint_ = 0;
+  // Attached threads are parked during the atomic pause, so their objects are
+  // accounted in marked_bytes as well.
+  attached_threads_bytes_since_safepoint_.store(0, std::memory_order_relaxed);
 
   ForAllAllocationObservers([marked_bytes](AllocationObserver* observer) {
     observer->ResetAllocatedObjectSize(marked_bytes);
@@ -116,6 +143,14 @@ void StatsCollector::NotifySweepingCompleted() {
   current_ = Event();
 }
 
+void StatsCollector::NotifyFinalizersInvoked(GCInfoIndex gc_info_index,
+                                             size_t invocations,
+                                             v8::base::TimeDelta time) {
+  FinalizerStats& stats = current_.finalizer_stats[gc_info_index];
+  stats.invocations += invocations;
+  stats.time += time;
+}
+
 size_t StatsCollector::allocated_object_size() const {
   // During sweeping we refer to the current Event as that already holds the
   // correct marking information. In all other phases, the previous event holds
@@ -8,8 +8,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
+#include <unordered_map>
 #include <vector>
 
+#include "include/cppgc/internal/gc-info.h"
 #include "src/base/macros.h"
 #include "src/base/platform/time.h"
 #include "src/heap/cppgc/garbage-collector.h"
@@ -78,7 +81,13 @@ class V8_EXPORT_PRIVATE StatsCollector final {
         kNumConcurrentScopeIds
   };
 
-  // POD to hold interesting data accumulated during a garbage collection cycle.
+  // Finalizers invoked for a single type during a garbage collection cycle.
+  struct FinalizerStats final {
+    size_t invocations = 0;
+    v8::base::TimeDelta time;
+  };
+
+  // Holds interesting data accumulated during a garbage collection cycle.
   //
   // The event is always fully populated when looking at previous events but
   // may only be partially populated when looking at the current event.
@@ -93,6 +102,8 @@ class V8_EXPORT_PRIVATE StatsCollector final {
     IsForcedGC is_forced_gc = IsForcedGC::kNotForced;
     // Marked bytes collected during marking.
     size_t marked_bytes = 0;
+    // Finalizers invoked by the sweeper, keyed by the GCInfoIndex of the type.
+    std::unordered_map<GCInfoIndex, FinalizerStats> finalizer_stats;
   };
 
  private:
@@ -230,6 +241,11 @@ class V8_EXPORT_PRIVATE StatsCollector final {
   // This is necessary as increments and decrements are reported as close to
   // their actual allocation/reclamation as possible.
   void NotifySafePointForConservativeCollection();
+  // Variants of NotifyAllocation() and NotifyExplicitFree() for threads
+  // attached through cppgc::subtle::MutatorThreadScope. The bytes are handed to
+  // observers at the next safepoint of the thread owning the heap.
+  void NotifyAllocationOnAttachedThread(size_t);
+  void NotifyExplicitFreeOnAttachedThread(size_t);
 
   // Indicates a new garbage collection cycle.
   void NotifyMarkingStarted(CollectionType, IsForcedGC);
@@ -239,6 +255,10 @@ class V8_EXPORT_PRIVATE StatsCollector final {
   // Indicates the end of a garbage collection cycle. This means that sweeping
   // is finished at this point.
   void NotifySweepingCompleted();
+  // Records |invocations| finalizers of the type |gc_info_index| that were
+  // invoked in a batch taking |time|.
+  void NotifyFinalizersInvoked(GCInfoIndex gc_info_index, size_t invocations,
+                               v8::base::TimeDelta time);
 
   // Size of live objects in bytes  on the heap. Based on the most recent marked
   // bytes and the bytes allocated since last marking.
@@ -273,6 +293,8 @@ class V8_EXPORT_PRIVATE StatsCollector final {
   // arithmetic for simplicity.
   int64_t allocated_bytes_since_safepoint_ = 0;
   int64_t explicitly_freed_bytes_since_safepoint_ = 0;
+  // Net bytes allocated on attached threads since the last safepoint.
+  std::atomic<int64_t> attached_threads_bytes_since_safepoint_{0};
 
   // vector to allow fast iteration of observers. Register/Unregisters only
   // happens on startup/teardown.
@@ -4,6 +4,7 @@
 
 #include "src/heap/cppgc/sweeper.h"
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <vector>
@@ -12,6 +13,7 @@
 #include "src/base/optional.h"
 #include "src/base/platform/mutex.h"
 #include "src/heap/cppgc/free-list.h"
+#include "src/heap/cppgc/gc-info-table.h"
 #include "src/heap/cppgc/globals.h"
 #include "src/heap/cppgc/heap-base.h"
 #include "src/heap/cppgc/heap-object-header.h"
@@ -92,6 +94,11 @@ class ThreadSafeStack {
     return vector_.empty();
   }
 
+  size_t Size() const {
+    v8::base::LockGuard<v8::base::Mutex> lock(&mutex_);
+    return vector_.size();
+  }
+
  private:
   std::vector<T> vector_;
   mutable v8::base::Mutex mutex_;
@@ -119,30 +126,8 @@ void StickyUnmark(HeapObjectHeader* header) {
 #endif
 }
 
-// Builder that finalizes objects and adds freelist entries right away.
-class InlinedFinalizationBuilder final {
- public:
-  using ResultType = bool;
-
-  explicit InlinedFinalizationBuilder(BasePage* page) : page_(page) {}
-
-  void AddFinalizer(HeapObjectHeader* header, size_t size) {
-    header->Finalize();
-    SET_MEMORY_INACCESSIBLE(header, size);
-  }
-
-  void AddFreeListEntry(Address start, size_t size) {
-    auto* space = NormalPageSpace::From(page_->space());
-    space->free_list().Add({start, size});
-  }
-
-  ResultType GetResult(bool is_empty) { return is_empty; }
-
- private:
-  BasePage* page_;
-};
-
-// Builder that produces results for deferred processing.
+// Builder that produces results for deferred processing. Objects of
+// trivially destructible types are released right away.
 class DeferredFinalizationBuilder final {
  public:
   using ResultType = SpaceState::SweptPageState;
@@ -226,14 +211,54 @@ typename FinalizationBuilder::ResultType SweepNormalPage(NormalPage* page) {
   return builder.GetResult(is_empty);
 }
 
+// Sweeps |page| and returns the state that needs finalization on the mutator
+// thread. Pages that hold no finalizable dead objects and are either empty or
+// large are finished right away, which is safe on any thread.
+Optional<SpaceState::SweptPageState> SweepPage(BasePage* page) {
+  if (!page->is_large()) {
+    SpaceState::SweptPageState result =
+        SweepNormalPage<DeferredFinalizationBuilder>(NormalPage::From(page));
+    if (result.is_empty && result.unfinalized_objects.empty()) {
+      NormalPage::Destroy(NormalPage::From(page));
+      return v8::base::nullopt;
+    }
+    return std::move(result);
+  }
+
+  LargePage* large_page = LargePage::From(page);
+  HeapObjectHeader* header = large_page->ObjectHeader();
+  if (header->IsMarked()) {
+    StickyUnmark(header);
+    page->space()->AddPage(page);
+    return v8::base::nullopt;
+  }
+  if (!header->IsFinalizable()) {
+    LargePage::Destroy(large_page);
+    return v8::base::nullopt;
+  }
+  return SpaceState::SweptPageState{page, {header}, {}, {}, true};
+}
+
 // SweepFinalizer is responsible for heap/space/page finalization. Finalization
 // is defined as a step following concurrent sweeping which:
 // - calls finalizers;
 // - returns (unmaps) empty pages;
 // - merges freelists to the space's freelist.
+//
+// Pages are finalized in batches. The finalizers of a batch are sorted by type
+// (GCInfoIndex) and then by address, so that the finalizer of a type and the
+// data it touches stay in cache while all objects of the type are finalized.
+// The time spent per type is reported to the StatsCollector.
 class SweepFinalizer final {
  public:
-  explicit SweepFinalizer(cppgc::Platform* platform) : platform_(platform) {}
+  using PageBatch = std::vector<SpaceState::SweptPageState>;
+
+  // Number of pages that are finalized together. Also the granularity of
+  // deadline checks.
+  static constexpr size_t kPagesPerBatch = 8;
+
+  SweepFinalizer(cppgc::Platform* platform, StatsCollector* stats_collector)
+      : platform_(platform), stats_collector_(stats_collector) {}
 
   void FinalizeHeap(SpaceStates* space_states) {
     for (SpaceState& space_state : *space_states) {
@@ -242,29 +267,79 @@ class SweepFinalizer final {
   }
 
   void FinalizeSpace(SpaceState* space_state) {
-    while (auto page_state = space_state->swept_unfinalized_pages.Pop()) {
-      FinalizePage(&*page_state);
+    PageBatch batch;
+    while (PopBatch(space_state, &batch)) {
+      FinalizeBatch(&batch);
     }
   }
 
   bool FinalizeSpaceWithDeadline(SpaceState* space_state,
                                  double deadline_in_seconds) {
     DCHECK(platform_);
-    static constexpr size_t kDeadlineCheckInterval = 8;
-    size_t page_count = 1;
-
-    while (auto page_state = space_state->swept_unfinalized_pages.Pop()) {
-      FinalizePage(&*page_state);
-
-      if (page_count % kDeadlineCheckInterval == 0 &&
-          deadline_in_seconds <= platform_->MonotonicallyIncreasingTime()) {
+    PageBatch batch;
+    while (PopBatch(space_state, &batch)) {
+      FinalizeBatch(&batch);
+      if (deadline_in_seconds <= platform_->MonotonicallyIncreasingTime()) {
         return false;
       }
+    }
+    return true;
+  }
 
-      page_count++;
+  // Invokes the finalizers of all pages in |batch| grouped by type and then
+  // finalizes the pages. Clears |batch|.
+  void FinalizeBatch(PageBatch* batch) {
+    InvokeFinalizers(batch);
+    for (SpaceState::SweptPageState& page_state : *batch) {
+      FinalizePage(&page_state);
+    }
+    batch->clear();
+  }
+
+ private:
+  static bool PopBatch(SpaceState* space_state, PageBatch* batch) {
+    DCHECK(batch->empty());
+    while (batch->size() < kPagesPerBatch) {
+      auto page_state = space_state->swept_unfinalized_pages.Pop();
+      if (!page_state) break;
+      batch->push_back(std::move(*page_state));
     }
+    return !batch->empty();
+  }
 
-    return true;
+  void InvokeFinalizers(PageBatch* batch) {
+    objects_.clear();
+    for (const SpaceState::SweptPageState& page_state : *batch) {
+      objects_.insert(objects_.end(), page_state.unfinalized_objects.begin(),
+                      page_state.unfinalized_objects.end());
+    }
+    if (objects_.empty()) return;
+
+    std::sort(objects_.begin(), objects_.end(),
+              [](HeapObjectHeader* a, HeapObjectHeader* b) {
+                const GCInfoIndex a_index = a->GetGCInfoIndex();
+                const GCInfoIndex b_index = b->GetGCInfoIndex();
+                return a_index < b_index || (a_index == b_index && a < b);
+              });
+
+    for (auto it = objects_.begin(); it != objects_.end();) {
+      const GCInfoIndex gc_info_index = (*it)->GetGCInfoIndex();
+      const FinalizationCallback finalize =
+          GlobalGCInfoTable::GCInfoFromIndex(gc_info_index).finalize;
+      // Only finalizable objects are deferred.
+      DCHECK_NOT_NULL(finalize);
+      const v8::base::TimeTicks start = v8::base::TimeTicks::Now();
+      size_t count = 0;
+      for (; it != objects_.end() && (*it)->GetGCInfoIndex() == gc_info_index;
+           ++it, ++count) {
+        HeapObjectHeader* header = *it;
+        const size_t size = header->GetSize();
+        finalize(header->Payload());
+        SET_MEMORY_INACCESSIBLE(header, size);
+      }
+      stats_collector_->NotifyFinalizersInvoked(
+          gc_info_index, count, v8::base::TimeTicks::Now() - start);
+    }
   }
 
   void FinalizePage(SpaceState::SweptPageState* page_state) {
@@ -272,13 +347,6 @@ class SweepFinalizer final {
     DCHECK(page_state->page);
     BasePage* page = page_state->page;
 
-    // Call finalizers.
-    for (HeapObjectHeader* object : page_state->unfinalized_objects) {
-      const size_t size = object->GetSize();
-      object->Finalize();
-      SET_MEMORY_INACCESSIBLE(object, size);
-    }
-
     // Unmap page if empty.
     if (page_state->is_empty) {
       BasePage::Destroy(page);
@@ -301,22 +369,28 @@ class SweepFinalizer final {
     page->space()->AddPage(page);
   }
 
- private:
   cppgc::Platform* platform_;
+  StatsCollector* stats_collector_;
+  // Scratch space for sorting the finalizers of a batch.
+  std::vector<HeapObjectHeader*> objects_;
 };
 
-class MutatorThreadSweeper final : private HeapVisitor<MutatorThreadSweeper> {
-  friend class HeapVisitor<MutatorThreadSweeper>;
-
+class MutatorThreadSweeper final {
  public:
-  explicit MutatorThreadSweeper(SpaceStates* states, cppgc::Platform* platform)
-      : states_(states), platform_(platform) {}
+  MutatorThreadSweeper(SpaceStates* states, cppgc::Platform* platform,
+                       StatsCollector* stats_collector)
+      : states_(states),
+        platform_(platform),
+        finalizer_(platform, stats_collector) {}
+
+  ~MutatorThreadSweeper() { DCHECK(batch_.empty()); }
 
   void Sweep() {
     for (SpaceState& state : *states_) {
       while (auto page = state.unswept_pages.Pop()) {
-        Traverse(*page);
+        SweepAndMaybeFinalizeBatch(*page);
       }
+      FinalizeBatch();
     }
   }
 
@@ -325,15 +399,14 @@ class MutatorThreadSweeper final : private HeapVisitor<MutatorThreadSweeper> {
     static constexpr double kSlackInSeconds = 0.001;
     for (SpaceState& state : *states_) {
       // FinalizeSpaceWithDeadline() and SweepSpaceWithDeadline() won't check
-      // the deadline until it sweeps 10 pages. So we give a small slack for
-      // safety.
+      // the deadline until they processed a batch of pages. So we give a small
+      // slack for safety.
       const double remaining_budget = deadline_in_seconds - kSlackInSeconds -
                                       platform_->MonotonicallyIncreasingTime();
       if (remaining_budget <= 0.) return false;
 
       // First, prioritize finalization of pages that were swept concurrently.
-      SweepFinalizer finalizer(platform_);
-      if (!finalizer.FinalizeSpaceWithDeadline(&state, deadline_in_seconds)) {
+      if (!finalizer_.FinalizeSpaceWithDeadline(&state, deadline_in_seconds)) {
         return false;
       }
 
@@ -347,51 +420,45 @@ class MutatorThreadSweeper final : private HeapVisitor<MutatorThreadSweeper> {
 
  private:
   bool SweepSpaceWithDeadline(SpaceState* state, double deadline_in_seconds) {
-    static constexpr size_t kDeadlineCheckInterval = 8;
+    static constexpr size_t kDeadlineCheckInterval =
+        SweepFinalizer::kPagesPerBatch;
     size_t page_count = 1;
     while (auto page = state->unswept_pages.Pop()) {
-      Traverse(*page);
+      SweepAndMaybeFinalizeBatch(*page);
       if (page_count % kDeadlineCheckInterval == 0 &&
           deadline_in_seconds <= platform_->MonotonicallyIncreasingTime()) {
+        FinalizeBatch();
         return false;
       }
       page_count++;
     }
-
+    FinalizeBatch();
     return true;
   }
 
-  bool VisitNormalPage(NormalPage* page) {
-    const bool is_empty = SweepNormalPage<InlinedFinalizationBuilder>(page);
-    if (is_empty) {
-      NormalPage::Destroy(page);
-    } else {
-      page->space()->AddPage(page);
+  void SweepAndMaybeFinalizeBatch(BasePage* page) {
+    if (auto page_state = SweepPage(page)) {
+      batch_.push_back(std::move(*page_state));
     }
-    return true;
+    if (batch_.size() >= SweepFinalizer::kPagesPerBatch) FinalizeBatch();
   }
 
-  bool VisitLargePage(LargePage* page) {
-    HeapObjectHeader* header = page->ObjectHeader();
-    if (header->IsMarked()) {
-      StickyUnmark(header);
-      page->space()->AddPage(page);
-    } else {
-      header->Finalize();
-      LargePage::Destroy(page);
-    }
-    return true;
+  void FinalizeBatch() {
+    if (!batch_.empty()) finalizer_.FinalizeBatch(&batch_);
   }
 
   SpaceStates* states_;
   cppgc::Platform* platform_;
+  SweepFinalizer finalizer_;
+  SweepFinalizer::PageBatch batch_;
 };
 
-class ConcurrentSweepTask final : public cppgc::JobTask,
-                                  private HeapVisitor<ConcurrentSweepTask> {
-  friend class HeapVisitor<ConcurrentSweepTask>;
-
+// Sweeps pages on background threads. Pages are swept in parallel by up to
+// kMaxConcurrentSweepers workers.
+class ConcurrentSweepTask final : public cppgc::JobTask {
  public:
+  static constexpr size_t kMaxConcurrentSweepers = 3;
+
   explicit ConcurrentSweepTask(HeapBase& heap, SpaceStates* states)
       : heap_(heap), states_(states) {}
 
@@ -401,45 +468,33 @@ class ConcurrentSweepTask final : public cppgc::JobTask,
 
     for (SpaceState& state : *states_) {
       while (auto page = state.unswept_pages.Pop()) {
-        Traverse(*page);
+        SweepPageOnBackgroundThread(*page);
         if (delegate->ShouldYield()) return;
       }
     }
     is_completed_.store(true, std::memory_order_relaxed);
   }
 
-  size_t GetMaxConcurrency(size_t /* active_worker_count */) const final {
-    return is_completed_.load(std::memory_order_relaxed) ? 0 : 1;
+  size_t GetMaxConcurrency(size_t active_worker_count) const final {
+    if (is_completed_.load(std::memory_order_relaxed)) return 0;
+    size_t unswept_pages = 0;
+    for (const SpaceState& state : *states_) {
+      unswept_pages += state.unswept_pages.Size();
+    }
+    const size_t wanted_workers = active_worker_count + unswept_pages;
+    return wanted_workers < kMaxConcurrentSweepers ? wanted_workers
+                                                   : kMaxConcurrentSweepers;
   }
 
  private:
-  bool VisitNormalPage(NormalPage* page) {
-    SpaceState::SweptPageState sweep_result =
-        SweepNormalPage<DeferredFinalizationBuilder>(page);
-    const size_t space_index = page->space()->index();
-    DCHECK_GT(states_->size(), space_index);
-    SpaceState& space_state = (*states_)[space_index];
-    space_state.swept_unfinalized_pages.Push(std::move(sweep_result));
-    return true;
-  }
-
-  bool VisitLargePage(LargePage* page) {
-    HeapObjectHeader* header = page->ObjectHeader();
-    if (header->IsMarked()) {
-      StickyUnmark(header);
-      page->space()->AddPage(page);
-      return true;
-    }
-    if (!header->IsFinalizable()) {
-      LargePage::Destroy(page);
-      return true;
-    }
+  void SweepPageOnBackgroundThread(BasePage* page) {
+    // Read the index upfront as the page may be released by SweepPage().
     const size_t space_index = page->space()->index();
+    auto page_state = SweepPage(page);
+    if (!page_state) return;
     DCHECK_GT(states_->size(), space_index);
-    SpaceState& state = (*states_)[space_index];
-    state.swept_unfinalized_pages.Push(
-        {page, {page->ObjectHeader()}, {}, {}, true});
-    return true;
+    (*states_)[space_index].swept_unfinalized_pages.Push(
+        std::move(*page_state));
   }
 
   HeapBase& heap_;
@@ -544,11 +599,11 @@ class Sweeper::SweeperImpl final {
     DCHECK(is_in_progress_);
 
     // First, call finalizers on the mutator thread.
-    SweepFinalizer finalizer(platform_);
+    SweepFinalizer finalizer(platform_, stats_collector_);
     finalizer.FinalizeHeap(&space_states_);
 
     // Then, help out the concurrent thread.
-    MutatorThreadSweeper sweeper(&space_states_, platform_);
+    MutatorThreadSweeper sweeper(&space_states_, platform_, stats_collector_);
     sweeper.Sweep();
 
     FinalizeSweep();
@@ -604,7 +659,8 @@ class Sweeper::SweeperImpl final {
             *sweeper_->heap_->heap(), StatsCollector::kIncrementalSweep);
 
         MutatorThreadSweeper sweeper(&sweeper_->space_states_,
-                                     sweeper_->platform_);
+                                     sweeper_->platform_,
+                                     sweeper_->stats_collector_);
         {
           StatsCollector::EnabledScope stats_scope(
               *sweeper_->heap_->heap(), StatsCollector::kSweepIdleStep,
@@ -657,7 +713,7 @@ class Sweeper::SweeperImpl final {
   void SynchronizeAndFinalizeConcurrentSweeping() {
     CancelSweepers();
 
-    SweepFinalizer finalizer(platform_);
+    SweepFinalizer finalizer(platform_, stats_collector_);
     finalizer.FinalizeHeap(&space_states_);
   }
 
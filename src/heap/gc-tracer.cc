@@ -133,7 +133,8 @@ GCTracer::Event::Event(Type type, GarbageCollectionReason gc_reason,
       young_object_size(0),
       survived_young_object_size(0),
       incremental_marking_bytes(0),
-      incremental_marking_duration(0.0) {
+      incremental_marking_duration(0.0),
+      marking_throughput(0.0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
@@ -604,6 +605,8 @@ void GCTracer::PrintNVP() const {
           "allocated=%zu "
           "promoted=%zu "
           "semi_space_copied=%zu "
+          "remembered_set_slots=%zu "
+          "remembered_set_slots_filtered=%zu "
           "nodes_died_in_new=%d "
           "nodes_copied_in_new=%d "
           "nodes_promoted=%d "
@@ -646,6 +649,8 @@ void GCTracer::PrintNVP() const {
           current_.end_holes_size, allocated_since_last_gc,
           heap_->promoted_objects_size(),
           heap_->semi_space_copied_object_size(),
+          heap_->remembered_set_slots_visited(),
+          heap_->remembered_set_slots_filtered(),
           heap_->nodes_died_in_new_space_, heap_->nodes_copied_in_new_space_,
           heap_->nodes_promoted_, heap_->promotion_ratio_,
           AverageSurvivalRatio(), heap_->promotion_rate_,
@@ -783,7 +788,9 @@ void GCTracer::PrintNVP() const {
           "incremental_steps_count=%d "
           "incremental_marking_throughput=%.f "
           "incremental_walltime_duration=%.f "
+          "marking_throughput=%.1f "
           "background.mark=%.1f "
+          "background.clear.weak_collections=%.1f "
           "background.sweep=%.1f "
           "background.evacuate.copy=%.1f "
           "background.evacuate.update_pointers=%.1f "
@@ -881,8 +888,9 @@ void GCTracer::PrintNVP() const {
               .longest_step,
           current_.incremental_marking_scopes[Scope::MC_INCREMENTAL].steps,
           IncrementalMarkingSpeedInBytesPerMillisecond(),
-          incremental_walltime_duration,
+          incremental_walltime_duration, current_.marking_throughput,
           current_.scopes[Scope::MC_BACKGROUND_MARKING],
+          current_.scopes[Scope::MC_BACKGROUND_CLEAR_WEAK_COLLECTIONS],
           current_.scopes[Scope::MC_BACKGROUND_SWEEPING],
           current_.scopes[Scope::MC_BACKGROUND_EVACUATE_COPY],
           current_.scopes[Scope::MC_BACKGROUND_EVACUATE_UPDATE_POINTERS],
@@ -1262,6 +1270,8 @@ void GCTracer::RecordGCSumCounters(double atomic_pause_duration) {
       background_counter_[Scope::MC_BACKGROUND_EVACUATE_UPDATE_POINTERS]
           .total_duration_ms +
       background_counter_[Scope::MC_BACKGROUND_MARKING].total_duration_ms +
+      background_counter_[Scope::MC_BACKGROUND_CLEAR_WEAK_COLLECTIONS]
+          .total_duration_ms +
       background_counter_[Scope::MC_BACKGROUND_SWEEPING].total_duration_ms;
 
   const double marking_duration =
@@ -1276,6 +1286,30 @@ void GCTracer::RecordGCSumCounters(double atomic_pause_duration) {
   const double marking_background_duration =
       background_counter_[Scope::MC_BACKGROUND_MARKING].total_duration_ms;
 
+  // Marking throughput including concurrent marking, which shows the effect of
+  // --marking-prefetch-distance. Uses the same filtering as the main thread
+  // marking throughput in RecordGCPhasesHistograms.
+  constexpr size_t kMinObjectSizeForReportingThroughput = 1024 * 1024;
+  const double overall_marking_duration =
+      marking_duration + marking_background_duration -
+      current_.scopes[Scope::MC_MARK_EMBEDDER_TRACING];
+  if (base::TimeTicks::IsHighResolution() &&
+      current_.end_object_size > kMinObjectSizeForReportingThroughput &&
+      overall_marking_duration > 0) {
+    current_.marking_throughput =
+        static_cast<double>(current_.end_object_size) /
+        overall_marking_duration * 1000 / MB;
+    heap_->isolate()->counters()->gc_marking_throughput()->AddSample(
+        static_cast<int>(current_.marking_throughput));
+  }
+
+  const double evacuation_duration = current_.scopes[Scope::MC_EVACUATE];
+  const double evacuation_background_duration =
+      background_counter_[Scope::MC_BACKGROUND_EVACUATE_COPY]
+          .total_duration_ms +
+      background_counter_[Scope::MC_BACKGROUND_EVACUATE_UPDATE_POINTERS]
+          .total_duration_ms;
+
   // UMA.
   heap_->isolate()->counters()->gc_mark_compactor()->AddSample(
       static_cast<int>(overall_duration));
@@ -1289,6 +1323,11 @@ void GCTracer::RecordGCSumCounters(double atomic_pause_duration) {
                        "V8.GCMarkCompactorMarkingSummary",
                        TRACE_EVENT_SCOPE_THREAD, "duration", marking_duration,
                        "background_duration", marking_background_duration);
+  TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("v8.gc"),
+                       "V8.GCMarkCompactorEvacuationSummary",
+                       TRACE_EVENT_SCOPE_THREAD, "duration",
+                       evacuation_duration, "background_duration",
+                       evacuation_background_duration);
 }
 
 }  // namespace internal
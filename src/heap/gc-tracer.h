@@ -92,7 +92,7 @@ class V8_EXPORT_PRIVATE GCTracer {
           LAST_INCREMENTAL_SCOPE - FIRST_INCREMENTAL_SCOPE + 1,
       FIRST_GENERAL_BACKGROUND_SCOPE = BACKGROUND_YOUNG_ARRAY_BUFFER_SWEEP,
       LAST_GENERAL_BACKGROUND_SCOPE = BACKGROUND_UNMAPPER,
-      FIRST_MC_BACKGROUND_SCOPE = MC_BACKGROUND_EVACUATE_COPY,
+      FIRST_MC_BACKGROUND_SCOPE = MC_BACKGROUND_CLEAR_WEAK_COLLECTIONS,
       LAST_MC_BACKGROUND_SCOPE = MC_BACKGROUND_SWEEPING,
       FIRST_TOP_MC_SCOPE = MC_CLEAR,
       LAST_TOP_MC_SCOPE = MC_SWEEP,
@@ -181,6 +181,10 @@ class V8_EXPORT_PRIVATE GCTracer {
     // Duration of incremental marking steps for INCREMENTAL_MARK_COMPACTOR.
     double incremental_marking_duration;
 
+    // Live bytes per second of main thread and background marking time in
+    // MB/s for MARK_COMPACTOR and INCREMENTAL_MARK_COMPACTOR.
+    double marking_throughput;
+
     // Amounts of time spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
 
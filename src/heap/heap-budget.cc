@@ -0,0 +1,177 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-budget.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "include/v8-platform.h"
+#include "src/execution/isolate.h"
+#include "src/heap/heap.h"
+#include "src/init/v8.h"
+#include "src/tasks/cancelable-task.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Delivers a memory pressure notification on the thread of the notified
+// isolate, outside of the GC pause of the heap that requested it.
+class MemoryPressureTask final : public CancelableTask {
+ public:
+  MemoryPressureTask(Heap* heap, MemoryPressureLevel level)
+      : CancelableTask(heap->isolate()), heap_(heap), level_(level) {}
+
+  MemoryPressureTask(const MemoryPressureTask&) = delete;
+  MemoryPressureTask& operator=(const MemoryPressureTask&) = delete;
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    heap_->MemoryPressureNotification(level_, true);
+  }
+
+  Heap* const heap_;
+  const MemoryPressureLevel level_;
+};
+
+}  // namespace
+
+HeapBudget::HeapBudget(size_t budget, HeapBudgetExhaustedCallback callback,
+                       void* data)
+    : budget_(budget), callback_(callback), data_(data) {}
+
+HeapBudget::~HeapBudget() { DCHECK(entries_.empty()); }
+
+size_t HeapBudget::Used() const {
+  base::MutexGuard guard(&mutex_);
+  size_t used = 0;
+  for (const Entry& entry : entries_) used += entry.size;
+  return used;
+}
+
+void HeapBudget::Register(Heap* heap) {
+  base::MutexGuard guard(&mutex_);
+  DCHECK(std::none_of(
+      entries_.begin(), entries_.end(),
+      [heap](const Entry& entry) { return entry.heap == heap; }));
+  entries_.push_back({heap, 0, 0});
+}
+
+void HeapBudget::Unregister(Heap* heap) {
+  base::MutexGuard guard(&mutex_);
+  auto it = std::find_if(
+      entries_.begin(), entries_.end(),
+      [heap](const Entry& entry) { return entry.heap == heap; });
+  DCHECK(it != entries_.end());
+  entries_.erase(it);
+}
+
+size_t HeapBudget::UpdateAndGetAvailable(Heap* heap, size_t size) {
+  base::MutexGuard guard(&mutex_);
+  for (Entry& entry : entries_) {
+    if (entry.heap == heap) {
+      entry.size = size;
+      break;
+    }
+  }
+  return AvailableLocked(heap);
+}
+
+size_t HeapBudget::Available(Heap* heap) const {
+  base::MutexGuard guard(&mutex_);
+  return AvailableLocked(heap);
+}
+
+size_t HeapBudget::AvailableLocked(Heap* heap) const {
+  size_t used_by_others = 0;
+  for (const Entry& entry : entries_) {
+    if (entry.heap != heap) used_by_others += entry.size;
+  }
+  const size_t budget = Budget();
+  return budget > used_by_others ? budget - used_by_others : 0;
+}
+
+int HeapBudget::ReduceMemoryOfLargestHeaps(Heap* heap) {
+  std::vector<std::pair<std::shared_ptr<v8::TaskRunner>,
+                        std::unique_ptr<MemoryPressureTask>>>
+      notifications;
+  size_t used = 0;
+  const size_t budget = Budget();
+  MemoryPressureLevel level = MemoryPressureLevel::kNone;
+  {
+    base::MutexGuard guard(&mutex_);
+    const size_t threshold =
+        static_cast<size_t>(budget * kReduceMemoryThreshold);
+    for (const Entry& entry : entries_) used += entry.size;
+    if (used <= threshold) {
+      // The pressure is gone, so heaps may be notified again the next time.
+      for (Entry& entry : entries_) entry.notified_size = 0;
+      return 0;
+    }
+
+    std::vector<Entry*> candidates;
+    for (Entry& entry : entries_) {
+      if (entry.heap != heap && entry.size > 0) candidates.push_back(&entry);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Entry* a, const Entry* b) { return a->size > b->size; });
+
+    // Moderate pressure starts memory-reducing incremental marking, critical
+    // pressure performs a full GC right away.
+    level = used > budget ? MemoryPressureLevel::kCritical
+                          : MemoryPressureLevel::kModerate;
+    const size_t overshoot = used - threshold;
+    size_t covered = 0;
+    for (Entry* entry : candidates) {
+      if (covered >= overshoot) break;
+      covered += entry->size;
+      // A heap that has not grown since its last notification is still
+      // expected to shrink. Notifying it again on every limit update would
+      // just keep it busy with GCs.
+      if (entry->size <= entry->notified_size) continue;
+      entry->notified_size = entry->size;
+      // The task and the task runner are set up while the mutex keeps the
+      // other heap from being torn down. Once registered, the task is
+      // canceled if the isolate goes away before it runs.
+      v8::Isolate* isolate =
+          reinterpret_cast<v8::Isolate*>(entry->heap->isolate());
+      notifications.emplace_back(
+          V8::GetCurrentPlatform()->GetForegroundTaskRunner(isolate),
+          std::make_unique<MemoryPressureTask>(entry->heap, level));
+    }
+  }
+
+  for (auto& notification : notifications) {
+    notification.first->PostTask(std::move(notification.second));
+  }
+  const int notified = static_cast<int>(notifications.size());
+  if (FLAG_trace_gc_verbose) {
+    Isolate::FromHeap(heap)->PrintWithTimestamp(
+        "[HeapBudget] used: %zu KB, budget: %zu KB, notified %d heap(s) of "
+        "%s memory pressure\n",
+        used / KB, budget / KB, notified,
+        level == MemoryPressureLevel::kCritical ? "critical" : "moderate");
+  }
+  return notified;
+}
+
+bool HeapBudget::InvokeExhaustedCallback(Heap* heap) {
+  if (callback_ == nullptr) return false;
+  const size_t available_before = Available(heap);
+  const size_t budget = Budget();
+  // The callback may ask other isolates to reduce memory, so it must not run
+  // under the mutex.
+  const size_t new_budget =
+      callback_(data_, reinterpret_cast<v8::Isolate*>(heap->isolate()),
+                budget, Used());
+  if (new_budget > budget) SetBudget(new_budget);
+  return Available(heap) > available_before;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,92 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_HEAP_BUDGET_H_
+#define V8_HEAP_HEAP_BUDGET_H_
+
+#include <atomic>
+#include <vector>
+
+#include "include/v8.h"
+#include "src/base/platform/mutex.h"
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Implementation of v8::HeapBudget. Every registered heap publishes its old
+// generation size when MemoryController computes a new allocation limit. The
+// controller then caps the limit at the part of the budget that the other
+// heaps do not use. Sizes of other heaps are as of their last limit update,
+// which is good enough since limits are only recomputed after GCs anyway.
+//
+// When the sum of the sizes exceeds kReduceMemoryThreshold of the budget, the
+// heap that noticed it sends memory pressure notifications to the other heaps,
+// largest first, until the notified heaps cover the overshoot. The
+// notifications are posted as tasks and result in memory-reducing GCs on the
+// threads of the respective isolates. A heap is only notified again once it
+// has grown beyond its size at the last notification, or after the pressure
+// has gone away in between.
+class V8_EXPORT_PRIVATE HeapBudget final : public v8::HeapBudget {
+ public:
+  static constexpr double kReduceMemoryThreshold = 0.9;
+
+  HeapBudget(size_t budget, HeapBudgetExhaustedCallback callback, void* data);
+  ~HeapBudget() override;
+  HeapBudget(const HeapBudget&) = delete;
+  HeapBudget& operator=(const HeapBudget&) = delete;
+
+  // v8::HeapBudget overrides.
+  size_t Budget() const override {
+    return budget_.load(std::memory_order_relaxed);
+  }
+  void SetBudget(size_t budget) override {
+    budget_.store(budget, std::memory_order_relaxed);
+  }
+  size_t Used() const override;
+
+  void Register(Heap* heap);
+  void Unregister(Heap* heap);
+
+  // Records |size| as the old generation size of |heap| and returns the part
+  // of the budget that the other heaps do not use.
+  size_t UpdateAndGetAvailable(Heap* heap, size_t size);
+
+  // Returns the part of the budget that the heaps other than |heap| do not
+  // use.
+  size_t Available(Heap* heap) const;
+
+  // Asks the largest heaps other than |heap| to reduce memory if the budget
+  // is tight. Returns the number of newly notified heaps.
+  int ReduceMemoryOfLargestHeaps(Heap* heap);
+
+  // Invokes the embedder callback on behalf of |heap|, which is in a GC
+  // pause. Returns true if the callback raised the budget or if other heaps
+  // reported smaller sizes meanwhile.
+  bool InvokeExhaustedCallback(Heap* heap);
+
+ private:
+  struct Entry {
+    Heap* heap;
+    size_t size;
+    // The size at the last memory pressure notification, or 0 if the heap
+    // has not been notified since the pressure went away.
+    size_t notified_size;
+  };
+
+  size_t AvailableLocked(Heap* heap) const;
+
+  mutable base::Mutex mutex_;
+  std::vector<Entry> entries_;
+  std::atomic<size_t> budget_;
+  const HeapBudgetExhaustedCallback callback_;
+  void* const data_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_HEAP_BUDGET_H_
@@ -4,7 +4,10 @@
 
 #include "src/heap/heap-controller.h"
 
+#include <limits>
+
 #include "src/execution/isolate-inl.h"
+#include "src/heap/heap-budget.h"
 #include "src/heap/spaces.h"
 
 namespace v8 {
@@ -156,6 +159,19 @@ size_t MemoryController<Trait>::CalculateAllocationLimit(
                static_cast<uint64_t>(current_size) +
                    MinimumAllocationLimitGrowingStep(growing_mode)) +
       new_space_capacity;
+  if (Trait::kUsesHeapBudget && heap->heap_budget() != nullptr) {
+    // Only grow into the part of the shared budget that other heaps do not
+    // use. When the budget is exhausted the heap still gets a minimal step so
+    // that it does not collect on every allocation. Running out of budget is
+    // then detected as ineffective mark-compacts.
+    const size_t available =
+        heap->heap_budget()->UpdateAndGetAvailable(heap, current_size);
+    max_size = std::min(
+        max_size,
+        std::max(available,
+                 current_size +
+                     2 * MinimumAllocationLimitGrowingStep(growing_mode)));
+  }
   const uint64_t limit_above_min_size = std::max<uint64_t>(limit, min_size);
   const uint64_t halfway_to_the_max =
       (static_cast<uint64_t>(current_size) + max_size) / 2;
@@ -169,6 +185,56 @@ size_t MemoryController<Trait>::CalculateAllocationLimit(
   return result;
 }
 
+// The scavenge pause is dominated by copying the surviving objects, so a
+// semi-space of capacity C is expected to take C * survival_rate / speed
+// milliseconds to collect, where speed is measured for survived bytes.
+// Solving for C gives the largest capacity that fits into the target pause.
+size_t NewSpaceController::MaxCapacityForPause(double survival_rate,
+                                               double scavenge_speed,
+                                               double target_pause_ms) {
+  if (target_pause_ms <= 0 || scavenge_speed == 0) {
+    return std::numeric_limits<size_t>::max();
+  }
+  // Avoid unbounded capacities for workloads where nothing survives.
+  constexpr double kMinSurvivalRate = 1.0;
+  const double survival_ratio =
+      std::max(survival_rate, kMinSurvivalRate) / 100.0;
+  const double capacity = target_pause_ms * scavenge_speed / survival_ratio;
+  if (capacity >= static_cast<double>(std::numeric_limits<size_t>::max())) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return static_cast<size_t>(capacity);
+}
+
+size_t NewSpaceController::CalculateTargetCapacity(
+    Heap* heap, size_t current_capacity, size_t min_capacity,
+    size_t max_capacity, double survival_rate, double scavenge_speed,
+    double target_pause_ms) {
+  DCHECK_LE(min_capacity, max_capacity);
+  size_t target = current_capacity;
+  if (survival_rate < kLowSurvivalRate) {
+    // Most objects die young anyway. A smaller new space saves memory without
+    // causing noticeably more promotion.
+    target = current_capacity / FLAG_semi_space_growth_factor;
+  } else if (survival_rate > kHighSurvivalRate) {
+    // Give objects more time to die before they get promoted.
+    target = current_capacity * FLAG_semi_space_growth_factor;
+  }
+  const size_t pause_limit =
+      MaxCapacityForPause(survival_rate, scavenge_speed, target_pause_ms);
+  target = std::min(target, pause_limit);
+  target = std::max(std::min(target, max_capacity), min_capacity);
+  target = ::RoundDown(target, Page::kPageSize);
+  if (FLAG_trace_gc_verbose) {
+    Isolate::FromHeap(heap)->PrintWithTimestamp(
+        "[NewSpaceController] capacity: %zu KB -> %zu KB based on "
+        "survival=%.1f%%, speed=%.f, target_pause=%.1f ms\n",
+        current_capacity / KB, target / KB, survival_rate, scavenge_speed,
+        target_pause_ms);
+  }
+  return target;
+}
+
 template class V8_EXPORT_PRIVATE MemoryController<V8HeapTrait>;
 template class V8_EXPORT_PRIVATE MemoryController<GlobalMemoryTrait>;
 
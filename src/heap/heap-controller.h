@@ -21,10 +21,14 @@ struct BaseControllerTrait {
   static constexpr double kMaxGrowingFactor = 4.0;
   static constexpr double kConservativeGrowingFactor = 1.3;
   static constexpr double kTargetMutatorUtilization = 0.97;
+
+  // Whether the limit is capped by the HeapBudget shared with other heaps.
+  static constexpr bool kUsesHeapBudget = false;
 };
 
 struct V8HeapTrait : public BaseControllerTrait {
   static const char* kName;
+  static constexpr bool kUsesHeapBudget = true;
 };
 
 struct GlobalMemoryTrait : public BaseControllerTrait {
@@ -56,6 +60,33 @@ class V8_EXPORT_PRIVATE MemoryController : public AllStatic {
   FRIEND_TEST(MemoryControllerTest, MaxHeapGrowingFactor);
 };
 
+// Sizes the semi-spaces of the young generation from the observed survival
+// rate and scavenge speed. The capacity grows while enough objects survive to
+// benefit from giving them more time to die, shrinks during low-survival
+// bursts, and is capped so that the expected scavenge pause stays within the
+// configured target.
+class V8_EXPORT_PRIVATE NewSpaceController : public AllStatic {
+ public:
+  // Survival rates are given in percent of the new space size.
+  static constexpr double kLowSurvivalRate = 10.0;
+  static constexpr double kHighSurvivalRate = 20.0;
+
+  // Returns the semi-space capacity to use until the next young generation
+  // GC. The result is page-aligned and within [min_capacity, max_capacity].
+  static size_t CalculateTargetCapacity(Heap* heap, size_t current_capacity,
+                                        size_t min_capacity,
+                                        size_t max_capacity,
+                                        double survival_rate,
+                                        double scavenge_speed,
+                                        double target_pause_ms);
+
+  // Returns the largest young generation size that is expected to be
+  // scavenged within |target_pause_ms|.
+  static size_t MaxCapacityForPause(double survival_rate,
+                                    double scavenge_speed,
+                                    double target_pause_ms);
+};
+
 }  // namespace internal
 }  // namespace v8
 
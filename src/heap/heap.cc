@@ -30,6 +30,7 @@
 #include "src/execution/v8threads.h"
 #include "src/execution/vm-state-inl.h"
 #include "src/handles/global-handles.h"
+#include "src/heap/allocation-lifetime-profiler.h"
 #include "src/heap/array-buffer-sweeper.h"
 #include "src/heap/barrier.h"
 #include "src/heap/base/stack.h"
@@ -44,6 +45,7 @@
 #include "src/heap/finalization-registry-cleanup-task.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
+#include "src/heap/heap-budget.h"
 #include "src/heap/heap-controller.h"
 #include "src/heap/heap-write-barrier-inl.h"
 #include "src/heap/incremental-marking-inl.h"
@@ -62,6 +64,7 @@
 #include "src/heap/objects-visiting.h"
 #include "src/heap/paged-spaces-inl.h"
 #include "src/heap/read-only-heap.h"
+#include "src/heap/remembered-set-filter.h"
 #include "src/heap/remembered-set.h"
 #include "src/heap/safepoint.h"
 #include "src/heap/scavenge-job.h"
@@ -837,6 +840,7 @@ void Heap::GarbageCollectionPrologue() {
 
   // Reset GC statistics.
   promoted_objects_size_ = 0;
+  remembered_set_slots_visited_ = 0;
   previous_semi_space_copied_object_size_ = semi_space_copied_object_size_;
   semi_space_copied_object_size_ = 0;
   nodes_died_in_new_space_ = 0;
@@ -869,6 +873,12 @@ void Heap::GarbageCollectionPrologueInSafepoint() {
   TRACE_GC(tracer(), GCTracer::Scope::HEAP_PROLOGUE_SAFEPOINT);
   gc_count_++;
 
+  if (remembered_set_filter_) {
+    remembered_set_filter_->Stop();
+    remembered_set_slots_filtered_ = remembered_set_filter_->slots_removed();
+  }
+
+  FreeLocalHeapNewSpaceLabs();
   UpdateNewSpaceAllocationCounter();
   CheckNewSpaceExpansionCriteria();
   new_space_->ResetParkedAllocationBuffers();
@@ -1062,7 +1072,13 @@ void Heap::ProcessPretenuringFeedback() {
       }
     }
 
-    // Step 2: Deopt maybe tenured allocation sites if necessary.
+    // Step 2: Apply decisions from sampled object lifetimes.
+    if (allocation_lifetime_profiler_ &&
+        allocation_lifetime_profiler_->ProcessSamples()) {
+      trigger_deoptimization = true;
+    }
+
+    // Step 3: Deopt maybe tenured allocation sites if necessary.
     bool deopt_maybe_tenured = DeoptMaybeTenuredAllocationSites();
     if (deopt_maybe_tenured) {
       ForeachAllocationSite(
@@ -1152,6 +1168,19 @@ void Heap::GarbageCollectionEpilogueInSafepoint(GarbageCollector collector) {
 #undef UPDATE_FRAGMENTATION_FOR_SPACE
 #undef UPDATE_COUNTERS_AND_FRAGMENTATION_FOR_SPACE
 
+  if (FLAG_huge_pages_for_old_space) {
+#define UPDATE_HUGE_PAGE_COVERAGE_FOR_SPACE(space)                      \
+  if (space()->CommittedMemory() > 0) {                                 \
+    isolate_->counters()->huge_page_coverage_##space()->AddSample(      \
+        static_cast<int>(                                               \
+            (MemoryAllocator::HugePageCoveredBytes(space()) * 100.0) /  \
+            space()->CommittedMemory()));                               \
+  }
+    UPDATE_HUGE_PAGE_COVERAGE_FOR_SPACE(old_space)
+    UPDATE_HUGE_PAGE_COVERAGE_FOR_SPACE(code_space)
+#undef UPDATE_HUGE_PAGE_COVERAGE_FOR_SPACE
+  }
+
 #ifdef DEBUG
   // Old-to-new slot sets must be empty after each collection.
   for (SpaceIterator it(this); it.HasNext();) {
@@ -1175,9 +1204,15 @@ void Heap::GarbageCollectionEpilogueInSafepoint(GarbageCollector collector) {
 
   {
     TRACE_GC(tracer(), GCTracer::Scope::HEAP_EPILOGUE_REDUCE_NEW_SPACE);
-    ReduceNewSpaceSize();
+    if (FLAG_adaptive_semi_space_sizing) {
+      ResizeNewSpace();
+    } else {
+      ReduceNewSpaceSize();
+    }
   }
 
+  if (remembered_set_filter_) remembered_set_filter_->Start();
+
   // Resume all threads waiting for the GC.
   collection_barrier_->ResumeThreadsAwaitingCollection();
 }
@@ -1292,6 +1327,9 @@ TimedHistogram* Heap::GCTypePriorityTimer(GarbageCollector collector) {
 }
 
 TimedHistogram* Heap::GCTypeTimer(GarbageCollector collector) {
+  if (collector == MINOR_MARK_COMPACTOR) {
+    return isolate_->counters()->gc_minor_mark_compactor();
+  }
   if (IsYoungGenerationCollector(collector)) {
     return isolate_->counters()->gc_scavenger();
   }
@@ -2183,6 +2221,7 @@ void Heap::RecomputeLimits(GarbageCollector collector) {
               max_global_memory_size_, new_space_capacity,
               global_growing_factor, mode);
     }
+    if (heap_budget_) heap_budget_->ReduceMemoryOfLargestHeaps(this);
     CheckIneffectiveMarkCompact(
         old_gen_size, tracer()->AverageMarkCompactMutatorUtilization());
   } else if (HasLowYoungGenerationAllocationRate() &&
@@ -2314,6 +2353,11 @@ void Heap::MarkCompactPrologue() {
 }
 
 void Heap::CheckNewSpaceExpansionCriteria() {
+  if (FLAG_adaptive_semi_space_sizing) {
+    // The new space is resized by ResizeNewSpace() at the end of the GC.
+    new_lo_space()->SetCapacity(new_space()->Capacity());
+    return;
+  }
   if (new_space_->TotalCapacity() < new_space_->MaximumCapacity() &&
       survived_since_last_expansion_ > new_space_->TotalCapacity()) {
     // Grow the size of new space if there is room to grow, and enough data
@@ -3304,6 +3348,15 @@ void Heap::MakeLocalHeapLabsIterable() {
   });
 }
 
+void Heap::FreeLocalHeapNewSpaceLabs() {
+  if (!FLAG_concurrent_new_space_allocation) return;
+  DCHECK(safepoint()->IsActive());
+  safepoint()->IterateLocalHeaps([](LocalHeap* local_heap) {
+    local_heap->FreeNewSpaceLinearAllocationArea();
+  });
+  new_space()->FreeBackgroundLinearAllocationArea();
+}
+
 namespace {
 
 double ComputeMutatorUtilizationImpl(double mutator_speed, double gc_speed) {
@@ -3374,8 +3427,11 @@ bool Heap::IsIneffectiveMarkCompact(size_t old_generation_size,
                                     double mutator_utilization) {
   const double kHighHeapPercentage = 0.8;
   const double kLowMutatorUtilization = 0.4;
-  return old_generation_size >=
-             kHighHeapPercentage * max_old_generation_size() &&
+  size_t max_size = max_old_generation_size();
+  if (heap_budget_) {
+    max_size = std::min(max_size, heap_budget_->Available(this));
+  }
+  return old_generation_size >= kHighHeapPercentage * max_size &&
          mutator_utilization < kLowMutatorUtilization;
 }
 
@@ -3395,6 +3451,14 @@ void Heap::CheckIneffectiveMarkCompact(size_t old_generation_size,
       consecutive_ineffective_mark_compacts_ = 0;
       return;
     }
+    if (heap_budget_) {
+      HandleScope scope(isolate());
+      if (heap_budget_->InvokeExhaustedCallback(this)) {
+        // The callback increased the budget or freed memory elsewhere.
+        consecutive_ineffective_mark_compacts_ = 0;
+        return;
+      }
+    }
     FatalProcessOutOfMemory("Ineffective mark-compacts near heap limit");
   }
 }
@@ -3453,6 +3517,43 @@ void Heap::ReduceNewSpaceSize() {
   }
 }
 
+void Heap::ResizeNewSpace() {
+  if (FLAG_predictable) return;
+
+  if (ShouldReduceMemory() || !tracer()->SurvivalEventsRecorded()) {
+    ReduceNewSpaceSize();
+    return;
+  }
+
+  const size_t current_capacity = new_space_->TotalCapacity();
+  const size_t target_capacity = NewSpaceController::CalculateTargetCapacity(
+      this, current_capacity, new_space_->InitialTotalCapacity(),
+      new_space_->MaximumCapacity(), tracer()->AverageSurvivalRatio(),
+      tracer()->ScavengeSpeedInBytesPerMillisecond(kForSurvivedObjects),
+      YoungGenerationPauseTargetInMs());
+  if (target_capacity > current_capacity) {
+    new_space_->GrowTo(target_capacity);
+  } else if (target_capacity < current_capacity) {
+    new_space_->ShrinkTo(target_capacity);
+    UncommitFromSpace();
+  }
+  new_lo_space_->SetCapacity(new_space_->Capacity());
+}
+
+double Heap::YoungGenerationPauseTargetInMs() const {
+  return pause_budget_in_ms_ > 0 ? pause_budget_in_ms_
+                                 : FLAG_scavenge_pause_target_ms;
+}
+
+void Heap::SetGarbageCollectionPauseBudget(double budget_in_ms) {
+  DCHECK_LE(0.0, budget_in_ms);
+  pause_budget_in_ms_ = budget_in_ms;
+  if (FLAG_trace_gc_verbose) {
+    isolate()->PrintWithTimestamp("GC pause budget set to %.1f ms\n",
+                                  budget_in_ms);
+  }
+}
+
 void Heap::FinalizeIncrementalMarkingIfComplete(
     GarbageCollectionReason gc_reason) {
   if (incremental_marking()->IsMarking() &&
@@ -4776,6 +4877,14 @@ void Heap::ConfigureHeapDefault() {
   ConfigureHeap(constraints);
 }
 
+void Heap::ConfigureHeapBudget(std::shared_ptr<v8::HeapBudget> budget) {
+  DCHECK_NULL(heap_budget_);
+  heap_budget_ = std::static_pointer_cast<HeapBudget>(std::move(budget));
+  // The heap does not count towards the budget before it has published its
+  // size, so it cannot be asked to reduce memory before it is set up.
+  heap_budget_->Register(this);
+}
+
 void Heap::RecordStats(HeapStats* stats, bool take_snapshot) {
   *stats->start_marker = HeapStats::kStartMarker;
   *stats->end_marker = HeapStats::kEndMarker;
@@ -5273,6 +5382,17 @@ void Heap::SetUpSpaces() {
       this, ScavengeJob::YoungGenerationTaskTriggerSize(this)));
   new_space()->AddAllocationObserver(scavenge_task_observer_.get());
 
+  if (FLAG_sampled_pretenuring && FLAG_allocation_site_pretenuring) {
+    allocation_lifetime_profiler_.reset(new AllocationLifetimeProfiler(
+        this, FLAG_sampled_pretenuring_interval));
+    new_space()->AddAllocationObserver(
+        allocation_lifetime_profiler_->observer());
+  }
+
+  if (FLAG_concurrent_remembered_set_filtering) {
+    remembered_set_filter_.reset(new RememberedSetFilter(this));
+  }
+
   SetGetExternallyAllocatedMemoryInBytesCallback(
       DefaultGetExternallyAllocatedMemoryInBytesCallback);
 
@@ -5451,6 +5571,16 @@ void Heap::TearDown() {
   if (FLAG_concurrent_marking || FLAG_parallel_marking)
     concurrent_marking_->Pause();
 
+  if (remembered_set_filter_) {
+    remembered_set_filter_->Stop();
+    remembered_set_filter_.reset();
+  }
+
+  if (heap_budget_) {
+    heap_budget_->Unregister(this);
+    heap_budget_.reset();
+  }
+
   // It's too late for Heap::Verify() here, as parts of the Isolate are
   // already gone by the time this is called.
 
@@ -5471,6 +5601,12 @@ void Heap::TearDown() {
 
   new_space()->RemoveAllocationObserver(scavenge_task_observer_.get());
   scavenge_task_observer_.reset();
+
+  if (allocation_lifetime_profiler_) {
+    new_space()->RemoveAllocationObserver(
+        allocation_lifetime_profiler_->observer());
+    allocation_lifetime_profiler_.reset();
+  }
   scavenge_job_.reset();
 
   if (need_to_remove_stress_concurrent_allocation_observer_) {
@@ -5767,7 +5903,7 @@ void Heap::ClearRecordedSlot(HeapObject object, ObjectSlot slot) {
 
 // static
 int Heap::InsertIntoRememberedSetFromCode(MemoryChunk* chunk, Address slot) {
-  RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(chunk, slot);
+  RecordOldToNewSlot(chunk, slot);
   return 0;
 }
 
@@ -6560,7 +6696,25 @@ void Heap::WriteBarrierForCodeSlow(Code code) {
 void Heap::GenerationalBarrierSlow(HeapObject object, Address slot,
                                    HeapObject value) {
   MemoryChunk* chunk = MemoryChunk::FromHeapObject(object);
-  RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(chunk, slot);
+  RecordOldToNewSlot(chunk, slot);
+}
+
+// static
+void Heap::RecordOldToNewSlot(MemoryChunk* chunk, Address slot) {
+  // The RememberedSetFilter clears bits concurrently. Publishing the insert
+  // makes the filter see the young value that was just written to the slot.
+  if (FLAG_concurrent_remembered_set_filtering) {
+    RememberedSet<OLD_TO_NEW>::InsertAndPublish(chunk, slot);
+    return;
+  }
+  // Background threads with their own new space LABs record old-to-new slots
+  // concurrently with the main thread. The inline insert of the RecordWrite
+  // builtin always sets its bit with an atomic or.
+  if (FLAG_concurrent_new_space_allocation) {
+    RememberedSet<OLD_TO_NEW>::Insert<AccessMode::ATOMIC>(chunk, slot);
+  } else {
+    RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(chunk, slot);
+  }
 }
 
 void Heap::RecordEphemeronKeyWrite(EphemeronHashTable table, Address slot) {
@@ -6611,8 +6765,7 @@ void Heap::WriteBarrierForRangeImpl(MemoryChunk* source_page, HeapObject object,
 
     if ((kModeMask & kDoGenerational) &&
         Heap::InYoungGeneration(value_heap_object)) {
-      RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(source_page,
-                                                                slot.address());
+      RecordOldToNewSlot(source_page, slot.address());
     }
 
     if ((kModeMask & kDoMarking) &&
@@ -6703,6 +6856,14 @@ void Heap::GenerationalBarrierForCodeSlow(Code host, RelocInfo* rinfo,
   }
   uintptr_t offset = addr - source_page->address();
   DCHECK_LT(offset, static_cast<uintptr_t>(TypedSlotSet::kMaxOffset));
+  // A concurrent sweeper may be filtering the typed slots of this page.
+  base::Optional<base::MutexGuard> guard;
+  if (source_page->heap()
+          ->mark_compact_collector()
+          ->sweeper()
+          ->ShouldSweepCodeSpaceConcurrently()) {
+    guard.emplace(source_page->mutex());
+  }
   RememberedSet<OLD_TO_NEW>::InsertTyped(source_page, slot_type,
                                          static_cast<uint32_t>(offset));
 }
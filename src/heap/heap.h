@@ -62,6 +62,7 @@ class NativeContext;
 
 using v8::MemoryPressureLevel;
 
+class AllocationLifetimeProfiler;
 class ArrayBufferCollector;
 class ArrayBufferSweeper;
 class BasicMemoryChunk;
@@ -73,6 +74,7 @@ class GCIdleTimeHandler;
 class GCIdleTimeHeapState;
 class GCTracer;
 class GlobalSafepoint;
+class HeapBudget;
 class HeapObjectAllocationTracker;
 class HeapObjectsFilter;
 class HeapStats;
@@ -91,6 +93,7 @@ class ObjectStats;
 class Page;
 class PagedSpace;
 class ReadOnlyHeap;
+class RememberedSetFilter;
 class RootVisitor;
 class SafepointScope;
 class ScavengeJob;
@@ -684,6 +687,12 @@ class Heap {
                                                     bool is_isolate_locked);
   void CheckMemoryPressure();
 
+  // Implements the corresponding V8 API function. A budget of 0 disables the
+  // pause budget.
+  V8_EXPORT_PRIVATE void SetGarbageCollectionPauseBudget(double budget_in_ms);
+  double pause_budget_in_ms() const { return pause_budget_in_ms_; }
+  V8_EXPORT_PRIVATE double YoungGenerationPauseTargetInMs() const;
+
   V8_EXPORT_PRIVATE void AddNearHeapLimitCallback(v8::NearHeapLimitCallback,
                                                   void* data);
   V8_EXPORT_PRIVATE void RemoveNearHeapLimitCallback(
@@ -791,6 +800,11 @@ class Heap {
   void ConfigureHeap(const v8::ResourceConstraints& constraints);
   void ConfigureHeapDefault();
 
+  // Makes the heap share |budget| with the other heaps that use it.
+  V8_EXPORT_PRIVATE void ConfigureHeapBudget(
+      std::shared_ptr<v8::HeapBudget> budget);
+  HeapBudget* heap_budget() const { return heap_budget_.get(); }
+
   // Prepares the heap, setting up for deserialization.
   void SetUp();
 
@@ -864,6 +878,14 @@ class Heap {
     return array_buffer_sweeper_.get();
   }
 
+  AllocationLifetimeProfiler* allocation_lifetime_profiler() {
+    return allocation_lifetime_profiler_.get();
+  }
+
+  RememberedSetFilter* remembered_set_filter() {
+    return remembered_set_filter_.get();
+  }
+
   const base::AddressRegion& code_range();
 
   // ===========================================================================
@@ -1028,6 +1050,7 @@ class Heap {
   void ClearRecordedSlot(HeapObject object, ObjectSlot slot);
   void ClearRecordedSlotRange(Address start, Address end);
   static int InsertIntoRememberedSetFromCode(MemoryChunk* chunk, Address slot);
+  static void RecordOldToNewSlot(MemoryChunk* chunk, Address slot);
 
 #ifdef DEBUG
   void VerifyClearedSlot(HeapObject object, ObjectSlot slot);
@@ -1306,6 +1329,18 @@ class Heap {
   }
   inline size_t promoted_objects_size() { return promoted_objects_size_; }
 
+  inline void IncrementRememberedSetSlotsVisited(size_t slots) {
+    remembered_set_slots_visited_ += slots;
+  }
+  // Old-to-new slots visited by the last scavenge.
+  inline size_t remembered_set_slots_visited() {
+    return remembered_set_slots_visited_;
+  }
+  // Old-to-new slots removed by the RememberedSetFilter since the previous GC.
+  inline size_t remembered_set_slots_filtered() {
+    return remembered_set_slots_filtered_;
+  }
+
   inline void IncrementSemiSpaceCopiedObjectSize(size_t object_size) {
     semi_space_copied_object_size_ += object_size;
   }
@@ -1699,6 +1734,10 @@ class Heap {
   // Ensure that LABs of local heaps are iterable.
   void MakeLocalHeapLabsIterable();
 
+  // Gives up the new space LABs of local heaps, which would otherwise point
+  // into from-space after the next flip.
+  void FreeLocalHeapNewSpaceLabs();
+
   // Performs garbage collection in a safepoint.
   // Returns the number of freed global handles.
   size_t PerformGarbageCollection(
@@ -1764,6 +1803,10 @@ class Heap {
 
   void ReduceNewSpaceSize();
 
+  // Grows or shrinks the new space based on the survival rate and the young
+  // generation pause target (--adaptive-semi-space-sizing).
+  void ResizeNewSpace();
+
   GCIdleTimeHeapState ComputeHeapState();
 
   bool PerformIdleTimeAction(GCIdleTimeAction action,
@@ -2094,6 +2137,10 @@ class Heap {
   // and reset by a mark-compact garbage collection.
   std::atomic<MemoryPressureLevel> memory_pressure_level_;
 
+  // Soft upper bound for the duration of individual GC steps and pauses, as
+  // requested by the embedder. 0 means that no budget is set.
+  double pause_budget_in_ms_ = 0.0;
+
   std::vector<std::pair<v8::NearHeapLimitCallback, void*>>
       near_heap_limit_callbacks_;
 
@@ -2194,6 +2241,8 @@ class Heap {
   int deferred_counters_[v8::Isolate::kUseCounterFeatureCount];
 
   size_t promoted_objects_size_ = 0;
+  size_t remembered_set_slots_visited_ = 0;
+  size_t remembered_set_slots_filtered_ = 0;
   double promotion_ratio_ = 0.0;
   double promotion_rate_ = 0.0;
   size_t semi_space_copied_object_size_ = 0;
@@ -2234,6 +2283,9 @@ class Heap {
   std::unique_ptr<ObjectStats> dead_object_stats_;
   std::unique_ptr<ScavengeJob> scavenge_job_;
   std::unique_ptr<AllocationObserver> scavenge_task_observer_;
+  std::unique_ptr<AllocationLifetimeProfiler> allocation_lifetime_profiler_;
+  std::unique_ptr<RememberedSetFilter> remembered_set_filter_;
+  std::shared_ptr<HeapBudget> heap_budget_;
   std::unique_ptr<AllocationObserver> stress_concurrent_allocation_observer_;
   std::unique_ptr<LocalEmbedderHeapTracer> local_embedder_heap_tracer_;
   std::unique_ptr<MarkingBarrier> marking_barrier_;
@@ -777,7 +777,8 @@ StepResult IncrementalMarking::AdvanceWithDeadline(
 
   ScheduleBytesToMarkBasedOnTime(heap()->MonotonicallyIncreasingTimeInMs());
   FastForwardScheduleIfCloseToFinalization();
-  return Step(kStepSizeInMs, completion_action, step_origin);
+  return Step(BudgetedStepSizeInMs(kStepSizeInMs), completion_action,
+              step_origin);
 }
 
 size_t IncrementalMarking::StepSizeToKeepUpWithAllocations() {
@@ -878,7 +879,14 @@ void IncrementalMarking::AdvanceOnAllocation() {
   TRACE_EVENT0("v8", "V8.GCIncrementalMarking");
   TRACE_GC(heap_->tracer(), GCTracer::Scope::MC_INCREMENTAL);
   ScheduleBytesToMarkBasedOnAllocation();
-  Step(kMaxStepSizeInMs, GC_VIA_STACK_GUARD, StepOrigin::kV8);
+  Step(BudgetedStepSizeInMs(kMaxStepSizeInMs), GC_VIA_STACK_GUARD,
+       StepOrigin::kV8);
+}
+
+double IncrementalMarking::BudgetedStepSizeInMs(double step_size_in_ms) const {
+  const double budget = heap_->pause_budget_in_ms();
+  if (budget <= 0) return step_size_in_ms;
+  return std::min(step_size_in_ms, budget);
 }
 
 StepResult IncrementalMarking::Step(double max_step_size_in_ms,
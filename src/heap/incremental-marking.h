@@ -172,6 +172,9 @@ class V8_EXPORT_PRIVATE IncrementalMarking final {
   StepResult Step(double max_step_size_in_ms, CompletionAction action,
                   StepOrigin step_origin);
 
+  // Caps the given step duration by the embedder-provided pause budget.
+  double BudgetedStepSizeInMs(double step_size_in_ms) const;
+
   bool ShouldDoEmbedderStep();
   StepResult EmbedderStep(double expected_duration_ms, double* duration_ms);
 
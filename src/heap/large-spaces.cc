@@ -303,7 +303,7 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
         current->ClearOutOfLiveRangeSlots(free_start);
         const size_t bytes_to_free =
             current->size() - (free_start - current->address());
-        heap()->memory_allocator()->PartialFreeMemory(
+        heap()->memory_allocator()->PartialFreeMemoryConcurrently(
             current, free_start, bytes_to_free,
             current->area_start() + object.Size());
         size_ -= bytes_to_free;
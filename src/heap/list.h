@@ -79,6 +79,21 @@ class List {
 
   bool Empty() const { return !front_ && !back_; }
 
+  void InsertBefore(T* element, T* other) {
+    DCHECK(Contains(other));
+    DCHECK(!element->list_node().next());
+    DCHECK(!element->list_node().prev());
+    T* other_prev = other->list_node().prev();
+    element->list_node().set_next(other);
+    element->list_node().set_prev(other_prev);
+    other->list_node().set_prev(element);
+    if (other_prev) {
+      other_prev->list_node().set_next(element);
+    } else {
+      front_ = element;
+    }
+  }
+
   T* front() { return front_; }
   T* back() { return back_; }
 
@@ -108,18 +123,6 @@ class List {
       back_ = element;
   }
 
-  void InsertBefore(T* element, T* other) {
-    T* other_prev = other->list_node().prev();
-    element->list_node().set_next(other);
-    element->list_node().set_prev(other_prev);
-    other->list_node().set_prev(element);
-    if (other_prev) {
-      other_prev->list_node().set_next(element);
-    } else {
-      front_ = element;
-    }
-  }
-
   T* front_;
   T* back_;
 };
@@ -27,7 +27,17 @@ AllocationResult LocalHeap::AllocateRaw(int size_in_bytes, AllocationType type,
 #endif
 
   bool large_object = size_in_bytes > Heap::MaxRegularHeapObjectSize(type);
-  CHECK_EQ(type, AllocationType::kOld);
+  CHECK(type == AllocationType::kOld || type == AllocationType::kYoung);
+
+  // Young objects from background threads are allocated in old space unless
+  // background threads have their own new space LABs. When the new space is
+  // exhausted, fall back to old space instead of requesting a GC.
+  if (type == AllocationType::kYoung && !large_object &&
+      FLAG_concurrent_new_space_allocation && !is_main_thread()) {
+    AllocationResult result =
+        new_space_allocator()->AllocateRaw(size_in_bytes, alignment, origin);
+    if (!result.IsRetry()) return result;
+  }
 
   if (large_object)
     return heap()->lo_space()->AllocateRawBackground(this, size_in_bytes);
@@ -50,7 +50,8 @@ LocalHeap::LocalHeap(Heap* heap, ThreadKind kind,
       handles_(new LocalHandles),
       persistent_handles_(std::move(persistent_handles)),
       marking_barrier_(new MarkingBarrier(this)),
-      old_space_allocator_(this, heap->old_space()) {
+      old_space_allocator_(this, heap->old_space()),
+      new_space_allocator_(this, heap->new_space()) {
   heap_->safepoint()->AddLocalHeap(this, [this] {
     if (FLAG_local_heaps && !is_main_thread()) {
       WriteBarrier::SetForThread(marking_barrier_.get());
@@ -74,6 +75,7 @@ LocalHeap::~LocalHeap() {
 
   heap_->safepoint()->RemoveLocalHeap(this, [this] {
     old_space_allocator_.FreeLinearAllocationArea();
+    new_space_allocator_.FreeLinearAllocationArea();
 
     if (FLAG_local_heaps && !is_main_thread()) {
       marking_barrier_->Publish();
@@ -166,14 +168,21 @@ void LocalHeap::EnterSafepoint() {
 
 void LocalHeap::FreeLinearAllocationArea() {
   old_space_allocator_.FreeLinearAllocationArea();
+  new_space_allocator_.FreeLinearAllocationArea();
+}
+
+void LocalHeap::FreeNewSpaceLinearAllocationArea() {
+  new_space_allocator_.FreeLinearAllocationArea();
 }
 
 void LocalHeap::MakeLinearAllocationAreaIterable() {
   old_space_allocator_.MakeLinearAllocationAreaIterable();
+  new_space_allocator_.MakeLinearAllocationAreaIterable();
 }
 
 void LocalHeap::MarkLinearAllocationAreaBlack() {
   old_space_allocator_.MarkLinearAllocationAreaBlack();
+  new_space_allocator_.MarkLinearAllocationAreaBlack();
 }
 
 void LocalHeap::UnmarkLinearAllocationArea() {
@@ -92,6 +92,7 @@ class V8_EXPORT_PRIVATE LocalHeap {
 
   MarkingBarrier* marking_barrier() { return marking_barrier_.get(); }
   ConcurrentAllocator* old_space_allocator() { return &old_space_allocator_; }
+  ConcurrentAllocator* new_space_allocator() { return &new_space_allocator_; }
 
   // Mark/Unmark linear allocation areas black. Used for black allocation.
   void MarkLinearAllocationAreaBlack();
@@ -100,6 +101,10 @@ class V8_EXPORT_PRIVATE LocalHeap {
   // Give up linear allocation areas. Used for mark-compact GC.
   void FreeLinearAllocationArea();
 
+  // Give up the new space linear allocation area. Used for young generation
+  // GCs.
+  void FreeNewSpaceLinearAllocationArea();
+
   // Create filler object in linear allocation areas. Verifying requires
   // iterable heap.
   void MakeLinearAllocationAreaIterable();
@@ -183,6 +188,7 @@ class V8_EXPORT_PRIVATE LocalHeap {
   std::unique_ptr<MarkingBarrier> marking_barrier_;
 
   ConcurrentAllocator old_space_allocator_;
+  ConcurrentAllocator new_space_allocator_;
 
   friend class Heap;
   friend class GlobalSafepoint;
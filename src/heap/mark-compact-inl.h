@@ -264,7 +264,8 @@ void LiveObjectRange<mode>::iterator::AdvanceToNextValidObject() {
     }
 
     if (current_cell_ == 0) {
-      if (it_.Advance()) {
+      // Sparse pages have long runs of empty cells; skip them in bulk.
+      if (it_.AdvanceToNonZeroCell()) {
         cell_base_ = it_.CurrentCellBase();
         current_cell_ = *it_.CurrentCell();
       }
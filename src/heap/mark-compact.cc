@@ -608,6 +608,31 @@ void MarkCompactCollector::DrainSweepingWorklistForSpace(
   sweeper()->DrainSweepingWorklistForSpace(space);
 }
 
+EvacuationCostModel::EvacuationCostModel(
+    double compaction_speed_in_bytes_per_ms, double time_budget_in_ms)
+    : compaction_speed_in_bytes_per_ms_(compaction_speed_in_bytes_per_ms),
+      time_budget_in_ms_(time_budget_in_ms) {
+  DCHECK_LT(0, compaction_speed_in_bytes_per_ms_);
+}
+
+double EvacuationCostModel::CostInMs(size_t live_bytes, size_t slots) const {
+  return (live_bytes + slots * kBytesPerSlotUpdate) /
+         compaction_speed_in_bytes_per_ms_;
+}
+
+double EvacuationCostModel::MinReclaimedBytesPerMs() const {
+  // Evacuating a page has to free at least as much memory as it copies. The
+  // cost is derived from the same compaction speed, so both sides of the
+  // comparison are in bytes per millisecond of evacuation work.
+  return compaction_speed_in_bytes_per_ms_;
+}
+
+bool EvacuationCostModel::IsWorthEvacuating(size_t reclaimed_bytes,
+                                            double cost_in_ms) const {
+  if (cost_in_ms > time_budget_in_ms_) return false;
+  return reclaimed_bytes >= MinReclaimedBytesPerMs() * cost_in_ms;
+}
+
 void MarkCompactCollector::ComputeEvacuationHeuristics(
     size_t area_size, int* target_fragmentation_percent,
     size_t* max_evacuated_bytes) {
@@ -656,6 +681,98 @@ void MarkCompactCollector::ComputeEvacuationHeuristics(
   }
 }
 
+bool MarkCompactCollector::ShouldUseEvacuationCostModel() const {
+  // Memory reducing modes keep compacting aggressively. The model also needs
+  // compaction speed samples to estimate costs.
+  return FLAG_compaction_cost_model && !heap()->ShouldReduceMemory() &&
+         !heap()->ShouldOptimizeForMemoryUsage() &&
+         heap()->tracer()->CompactionSpeedInBytesPerMillisecond() != 0;
+}
+
+void MarkCompactCollector::SelectEvacuationCandidatesByCost(
+    PagedSpace* space, const std::vector<std::pair<size_t, Page*>>& pages,
+    int* candidate_count, size_t* total_live_bytes) {
+  // Code space evacuation additionally updates typed slots and flushes the
+  // instruction cache, so it only gets a fraction of the budget.
+  const double kCodeSpaceBudgetFraction = 0.25;
+  double time_budget_in_ms = FLAG_compaction_time_budget_ms;
+  if (space->identity() == CODE_SPACE) {
+    time_budget_in_ms *= kCodeSpaceBudgetFraction;
+  }
+  EvacuationCostModel model(
+      heap()->tracer()->CompactionSpeedInBytesPerMillisecond(),
+      time_budget_in_ms);
+
+  struct Candidate {
+    Page* page;
+    size_t live_bytes;
+    size_t reclaimed_bytes;
+    double cost_in_ms;
+  };
+  std::vector<Candidate> candidates;
+  candidates.reserve(pages.size());
+  const size_t area_size = space->AreaSize();
+  for (const auto& entry : pages) {
+    size_t live_bytes = entry.first;
+    Page* page = entry.second;
+    // Old-to-old slots are only recorded during marking, so old-to-new slots
+    // are the best available estimate for the pointer density of the page.
+    size_t slots = RememberedSet<OLD_TO_NEW>::Iterate(
+        page, [](MaybeObjectSlot slot) { return KEEP_SLOT; },
+        SlotSet::KEEP_EMPTY_BUCKETS);
+    size_t reclaimed_bytes = area_size - live_bytes;
+    double cost_in_ms = model.CostInMs(live_bytes, slots);
+    if (model.IsWorthEvacuating(reclaimed_bytes, cost_in_ms)) {
+      candidates.push_back({page, live_bytes, reclaimed_bytes, cost_in_ms});
+    }
+  }
+
+  // Prefer pages that reclaim the most memory per millisecond.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) {
+              return a.reclaimed_bytes * b.cost_in_ms >
+                     b.reclaimed_bytes * a.cost_in_ms;
+            });
+  double total_cost_in_ms = 0;
+  size_t total_reclaimed_bytes = 0;
+  size_t selected = 0;
+  for (const Candidate& candidate : candidates) {
+    if (total_cost_in_ms + candidate.cost_in_ms > time_budget_in_ms) break;
+    total_cost_in_ms += candidate.cost_in_ms;
+    total_reclaimed_bytes += candidate.reclaimed_bytes;
+    *total_live_bytes += candidate.live_bytes;
+    selected++;
+  }
+
+  // Avoid (compact -> expand) cycles.
+  size_t estimated_new_pages = (*total_live_bytes + area_size - 1) / area_size;
+  if (selected <= estimated_new_pages) {
+    selected = 0;
+    total_cost_in_ms = 0;
+    total_reclaimed_bytes = 0;
+    *total_live_bytes = 0;
+  }
+  for (size_t i = 0; i < selected; i++) {
+    AddEvacuationCandidate(candidates[i].page);
+  }
+  *candidate_count = static_cast<int>(selected);
+
+  if (FLAG_trace_fragmentation) {
+    PrintIsolate(isolate(),
+                 "compaction-plan: space=%s budget_ms=%.2f "
+                 "min_reclaimed_kb_per_ms=%.1f considered=%zu worthwhile=%zu "
+                 "selected=%zu estimated_cost_ms=%.2f reclaimed_kb=%zu\n",
+                 space->name(), time_budget_in_ms,
+                 model.MinReclaimedBytesPerMs() / KB, pages.size(),
+                 candidates.size(), selected, total_cost_in_ms,
+                 total_reclaimed_bytes / KB);
+  }
+  TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("v8.gc"),
+                       "V8.GCCompactionPlan", TRACE_EVENT_SCOPE_THREAD,
+                       "pages", static_cast<int>(selected), "estimated_cost_ms",
+                       total_cost_in_ms);
+}
+
 void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
   DCHECK(space->identity() == OLD_SPACE || space->identity() == CODE_SPACE);
 
@@ -671,6 +788,8 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
   size_t max_evacuated_bytes;
   int target_fragmentation_percent;
   size_t free_bytes_threshold;
+  const bool use_cost_model =
+      in_standard_path && ShouldUseEvacuationCostModel();
   if (in_standard_path) {
     // We use two conditions to decide whether a page qualifies as an evacuation
     // candidate, or not:
@@ -713,7 +832,7 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
     CHECK_NULL(p->typed_slot_set<OLD_TO_OLD>());
     CHECK(p->SweepingDone());
     DCHECK(p->area_size() == area_size);
-    if (in_standard_path) {
+    if (in_standard_path && !use_cost_model) {
       // Only the pages with at more than |free_bytes_threshold| free bytes are
       // considered for evacuation.
       if (area_size - p->allocated_bytes() >= free_bytes_threshold) {
@@ -762,6 +881,9 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
         AddEvacuationCandidate(p);
       }
     }
+  } else if (use_cost_model) {
+    SelectEvacuationCandidatesByCost(space, pages, &candidate_count,
+                                     &total_live_bytes);
   } else {
     // The following approach determines the pages that should be evacuated.
     //
@@ -1792,8 +1914,12 @@ size_t MarkCompactCollector::ProcessMarkingWorklist(size_t bytes_to_process) {
   size_t bytes_processed = 0;
   bool is_per_context_mode = local_marking_worklists()->IsPerContextMode();
   Isolate* isolate = heap()->isolate();
-  while (local_marking_worklists()->Pop(&object) ||
-         local_marking_worklists()->PopOnHold(&object)) {
+  MarkingPrefetchQueue prefetch_queue(FLAG_marking_prefetch_distance);
+  auto pop = [this](HeapObject* object) {
+    return local_marking_worklists()->Pop(object) ||
+           local_marking_worklists()->PopOnHold(object);
+  };
+  while (prefetch_queue.Pop(pop, &object)) {
     // Left trimming may result in grey or black filler objects on the marking
     // worklist. Ignore these objects.
     if (object.IsFreeSpaceOrFiller()) {
@@ -1833,6 +1959,9 @@ size_t MarkCompactCollector::ProcessMarkingWorklist(size_t bytes_to_process) {
       break;
     }
   }
+  prefetch_queue.Flush([this](HeapObject object) {
+    local_marking_worklists()->Push(object);
+  });
   return bytes_processed;
 }
 
@@ -2081,9 +2210,16 @@ void MarkCompactCollector::ClearNonLiveReferences() {
   }
   {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_CLEAR_WEAK_REFERENCES);
-    ClearWeakReferences();
-    ClearWeakCollections();
-    ClearJSWeakRefs();
+    if (FLAG_parallel_weak_collection_clearing) {
+      StartClearingWeakCollections();
+      ClearWeakReferences();
+      ClearJSWeakRefs();
+      FinishClearingWeakCollections();
+    } else {
+      ClearWeakReferences();
+      ClearWeakCollections();
+      ClearJSWeakRefs();
+    }
   }
 
   MarkDependentCodeForDeoptimization();
@@ -2452,6 +2588,10 @@ void MarkCompactCollector::ClearWeakCollections() {
       }
     }
   }
+  ClearEphemeronRememberedSet();
+}
+
+void MarkCompactCollector::ClearEphemeronRememberedSet() {
   for (auto it = heap_->ephemeron_remembered_set_.begin();
        it != heap_->ephemeron_remembered_set_.end();) {
     if (!non_atomic_marking_state()->IsBlackOrGrey(it->first)) {
@@ -2462,6 +2602,143 @@ void MarkCompactCollector::ClearWeakCollections() {
   }
 }
 
+// Removes entries with dead keys from ephemeron hash tables. Each worker
+// claims ranges of entries, so that ranges of the same table are cleared
+// concurrently. Ranges never overlap, and the element count of a table is
+// updated by the worker that clears its last range.
+class ClearWeakCollectionsJob final : public v8::JobTask {
+ public:
+  static constexpr int kEntriesPerRange = 4 * KB;
+  static constexpr size_t kMaxTasks = 8;
+
+  ClearWeakCollectionsJob(Isolate* isolate,
+                          MarkCompactCollector::MarkingState* marking_state)
+      : isolate_(isolate),
+        marking_state_(marking_state),
+        tracer_(isolate->heap()->tracer()) {}
+
+  void AddTable(EphemeronHashTable table) {
+    const int capacity = table.Capacity();
+    const int ranges = (capacity + kEntriesPerRange - 1) / kEntriesPerRange;
+    if (ranges == 0) return;
+    tables_.push_back(std::make_unique<Table>(table, ranges));
+    Table* entry = tables_.back().get();
+    for (int start = 0; start < capacity; start += kEntriesPerRange) {
+      ranges_.push_back({entry, start, std::min(start + kEntriesPerRange,
+                                                capacity)});
+    }
+    remaining_ranges_.store(ranges_.size(), std::memory_order_relaxed);
+  }
+
+  bool IsEmpty() const { return ranges_.empty(); }
+
+  void Run(JobDelegate* delegate) override {
+    if (delegate->IsJoiningThread()) {
+      // Accounted for by MC_CLEAR_WEAK_COLLECTIONS of the caller.
+      ClearRanges(delegate);
+    } else {
+      TRACE_GC_EPOCH(tracer_,
+                     GCTracer::Scope::MC_BACKGROUND_CLEAR_WEAK_COLLECTIONS,
+                     ThreadKind::kBackground);
+      ClearRanges(delegate);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    return std::min<size_t>(
+        kMaxTasks, remaining_ranges_.load(std::memory_order_relaxed));
+  }
+
+ private:
+  struct Table {
+    Table(EphemeronHashTable table, int ranges)
+        : table(table), remaining_ranges(ranges) {}
+    EphemeronHashTable table;
+    std::atomic<int> removed{0};
+    std::atomic<int> remaining_ranges;
+  };
+
+  struct Range {
+    Table* table;
+    int start;
+    int end;
+  };
+
+  void ClearRanges(JobDelegate* delegate) {
+    while (!delegate->ShouldYield()) {
+      size_t index = next_range_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= ranges_.size()) return;
+      ClearRange(ranges_[index]);
+      remaining_ranges_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  void ClearRange(const Range& range) {
+    EphemeronHashTable table = range.table->table;
+    int removed = 0;
+    for (int i = range.start; i < range.end; i++) {
+      InternalIndex entry(i);
+      HeapObject key = HeapObject::cast(table.KeyAt(entry));
+#ifdef VERIFY_HEAP
+      if (FLAG_verify_heap) {
+        Object value = table.ValueAt(entry);
+        if (value.IsHeapObject()) {
+          CHECK_IMPLIES(
+              marking_state_->IsBlackOrGrey(key),
+              marking_state_->IsBlackOrGrey(HeapObject::cast(value)));
+        }
+      }
+#endif
+      if (!marking_state_->IsBlackOrGrey(key)) {
+        // Same as EphemeronHashTable::RemoveEntry() except for the element
+        // count, which other ranges of the table update concurrently.
+        table.set_the_hole(isolate_, EphemeronHashTable::EntryToIndex(entry));
+        table.set_the_hole(isolate_,
+                           EphemeronHashTable::EntryToValueIndex(entry));
+        removed++;
+      }
+    }
+    range.table->removed.fetch_add(removed, std::memory_order_relaxed);
+    if (range.table->remaining_ranges.fetch_sub(
+            1, std::memory_order_acq_rel) == 1) {
+      table.ElementsRemoved(
+          range.table->removed.load(std::memory_order_relaxed));
+    }
+  }
+
+  Isolate* const isolate_;
+  MarkCompactCollector::MarkingState* const marking_state_;
+  GCTracer* const tracer_;
+  std::vector<std::unique_ptr<Table>> tables_;
+  std::vector<Range> ranges_;
+  std::atomic<size_t> next_range_{0};
+  std::atomic<size_t> remaining_ranges_{0};
+};
+
+void MarkCompactCollector::StartClearingWeakCollections() {
+  DCHECK(!clear_weak_collections_job_);
+  auto job = std::make_unique<ClearWeakCollectionsJob>(isolate(),
+                                                       marking_state());
+  EphemeronHashTable table;
+  while (weak_objects_.ephemeron_hash_tables.Pop(kMainThreadTask, &table)) {
+    job->AddTable(table);
+  }
+  if (job->IsEmpty()) return;
+  clear_weak_collections_job_ = V8::GetCurrentPlatform()->PostJob(
+      TaskPriority::kUserBlocking, std::move(job));
+}
+
+void MarkCompactCollector::FinishClearingWeakCollections() {
+  TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_CLEAR_WEAK_COLLECTIONS);
+  // The remembered set is only accessed by the main thread and does not
+  // depend on the contents of the tables.
+  ClearEphemeronRememberedSet();
+  if (clear_weak_collections_job_) {
+    clear_weak_collections_job_->Join();
+    clear_weak_collections_job_.reset();
+  }
+}
+
 void MarkCompactCollector::ClearWeakReferences() {
   TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_CLEAR_WEAK_REFERENCES);
   std::pair<HeapObject, HeapObjectSlot> slot;
@@ -3931,14 +4208,7 @@ void MarkCompactCollector::UpdatePointersAfterEvacuation() {
 
   PointersUpdatingVisitor updating_visitor(isolate());
 
-  {
-    TRACE_GC(heap()->tracer(),
-             GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_TO_NEW_ROOTS);
-    // The external string table is updated at the end.
-    heap_->IterateRoots(&updating_visitor, base::EnumSet<SkipRoot>{
-                                               SkipRoot::kExternalStringTable});
-  }
-
+  std::unique_ptr<JobHandle> job_handle;
   {
     TRACE_GC(heap()->tracer(),
              GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_SLOTS_MAIN);
@@ -3957,13 +4227,32 @@ void MarkCompactCollector::UpdatePointersAfterEvacuation() {
     updating_items.push_back(
         std::make_unique<EphemeronTableUpdatingItem>(heap()));
 
-    V8::GetCurrentPlatform()
-        ->PostJob(v8::TaskPriority::kUserBlocking,
-                  std::make_unique<PointersUpdatingJob>(
-                      isolate(), std::move(updating_items), old_to_new_slots_,
-                      GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_PARALLEL,
-                      GCTracer::Scope::MC_BACKGROUND_EVACUATE_UPDATE_POINTERS))
-        ->Join();
+    // Remembered set and to-space slots are updated by background workers
+    // while the main thread updates the roots. Root slots live outside of the
+    // heap and only read forwarding addresses, so they do not race with the
+    // updating items. The main thread joins the job afterwards.
+    job_handle = V8::GetCurrentPlatform()->PostJob(
+        v8::TaskPriority::kUserBlocking,
+        std::make_unique<PointersUpdatingJob>(
+            isolate(), std::move(updating_items), old_to_new_slots_,
+            GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_PARALLEL,
+            GCTracer::Scope::MC_BACKGROUND_EVACUATE_UPDATE_POINTERS));
+  }
+
+  // The roots scope is a sibling of the slots scope, so that the tracer does
+  // not count the time spent on roots twice.
+  {
+    TRACE_GC(heap()->tracer(),
+             GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_TO_NEW_ROOTS);
+    // The external string table is updated at the end.
+    heap_->IterateRoots(&updating_visitor, base::EnumSet<SkipRoot>{
+                                               SkipRoot::kExternalStringTable});
+  }
+
+  {
+    TRACE_GC(heap()->tracer(),
+             GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_SLOTS_MAIN);
+    job_handle->Join();
   }
 
   {
@@ -75,6 +75,18 @@ class MarkBitCellIterator {
     return false;
   }
 
+  // Advances to the next cell that has a mark bit set. Returns false if there
+  // is no such cell, in which case the iterator is done.
+  V8_WARN_UNUSED_RESULT inline bool AdvanceToNonZeroCell() {
+    if (HasNext() && cells_[cell_index_ + 1] != 0) return Advance();
+    unsigned int new_cell_index =
+        Bitmap::FindNonZeroCell(cells_, cell_index_ + 1, last_cell_index_);
+    cell_base_ +=
+        (new_cell_index - cell_index_) * (Bitmap::kBitsPerCell * kTaggedSize);
+    cell_index_ = new_cell_index;
+    return cell_index_ != last_cell_index_;
+  }
+
   // Return the next mark bit cell. If there is no next it returns 0;
   inline MarkBit::CellType PeekNext() {
     if (HasNext()) {
@@ -429,6 +441,36 @@ class MainMarkingVisitor final
   bool revisiting_object_;
 };
 
+// Cost model for selecting evacuation candidates. The cost of evacuating a
+// page is the time to copy its live objects and update their recorded slots,
+// the benefit is the memory that becomes free. Both are measured in bytes of
+// compaction work, so a page is only worth evacuating if it frees at least as
+// many bytes as copying it and updating its slots amounts to.
+class V8_EXPORT_PRIVATE EvacuationCostModel {
+ public:
+  // Updating a recorded slot is assumed to be as expensive as copying this many
+  // bytes.
+  static constexpr size_t kBytesPerSlotUpdate = 4 * kTaggedSize;
+
+  EvacuationCostModel(double compaction_speed_in_bytes_per_ms,
+                      double time_budget_in_ms);
+
+  // Estimated time to evacuate a page with the given live bytes and slots.
+  double CostInMs(size_t live_bytes, size_t slots) const;
+
+  // Minimum number of bytes a page has to reclaim per millisecond of
+  // evacuation work.
+  double MinReclaimedBytesPerMs() const;
+
+  bool IsWorthEvacuating(size_t reclaimed_bytes, double cost_in_ms) const;
+
+  double time_budget_in_ms() const { return time_budget_in_ms_; }
+
+ private:
+  const double compaction_speed_in_bytes_per_ms_;
+  const double time_budget_in_ms_;
+};
+
 // Collector for young and old generation.
 class MarkCompactCollector final : public MarkCompactCollectorBase {
  public:
@@ -597,6 +639,16 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
                                    int* target_fragmentation_percent,
                                    size_t* max_evacuated_bytes);
 
+  // Returns true if evacuation candidates of |space| should be selected by
+  // EvacuationCostModel instead of the fragmentation heuristics.
+  bool ShouldUseEvacuationCostModel() const;
+
+  // Selects evacuation candidates from |pages|, pairs of (live bytes, page),
+  // within the compaction time budget of |space|.
+  void SelectEvacuationCandidatesByCost(
+      PagedSpace* space, const std::vector<std::pair<size_t, Page*>>& pages,
+      int* candidate_count, size_t* total_live_bytes);
+
   void RecordObjectStats();
 
   // Finishes GC, performs heap verification if enabled.
@@ -689,6 +741,14 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
   // The linked list of all encountered weak maps is destroyed.
   void ClearWeakCollections();
 
+  // Same as ClearWeakCollections() but clears the tables on background
+  // threads. Tables are split into ranges of entries, so a single huge
+  // WeakMap is cleared by several workers. The main thread clears the other
+  // weak references between the two calls.
+  void StartClearingWeakCollections();
+  void FinishClearingWeakCollections();
+  void ClearEphemeronRememberedSet();
+
   // Goes through the list of encountered weak references and clears those with
   // dead values. If the value is a dead map and the parent map transitions to
   // the dead map via weak cell, then this function also clears the map
@@ -764,6 +824,7 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
 
   std::unique_ptr<MarkingVisitor> marking_visitor_;
   std::unique_ptr<MarkingWorklists::Local> local_marking_worklists_;
+  std::unique_ptr<JobHandle> clear_weak_collections_job_;
   NativeContextInferrer native_context_inferrer_;
   NativeContextStats native_context_stats_;
 
@@ -463,6 +463,54 @@ int MarkingVisitorBase<ConcreteVisitor, MarkingState>::VisitTransitionArray(
   return size;
 }
 
+// ===========================================================================
+// Prefetching ==============================================================
+// ===========================================================================
+
+// static
+void MarkingPrefetchQueue::Prefetch(Address address) {
+#if V8_CC_GNU
+  // Prefetching is a hint that never faults, so it is fine if the object is
+  // concurrently being initialized or the address is stale.
+  __builtin_prefetch(reinterpret_cast<const void*>(address), 0, 3);
+#endif
+}
+
+template <typename PopCallback>
+bool MarkingPrefetchQueue::Pop(PopCallback pop, HeapObject* object) {
+  if (distance_ == 0) return pop(object);
+  HeapObject next;
+  while (size_ < distance_ && pop(&next)) {
+    // The first cache line holds the map word and the first fields, the
+    // second one covers the rest of the typical small object.
+    Prefetch(next.address());
+    Prefetch(next.address() + PROCESSOR_CACHE_LINE_SIZE);
+    objects_[(head_ + size_) % kMaxDistance] = next;
+    size_++;
+  }
+  if (size_ == 0) return false;
+  *object = objects_[head_];
+  head_ = (head_ + 1) % kMaxDistance;
+  size_--;
+  if (size_ > 0) {
+    // The header of the next object was prefetched when it entered the ring,
+    // so loading its map word is cheap. A relaxed load suffices as the map is
+    // only used as a hint.
+    Prefetch(objects_[head_].map_word().ToMap().address());
+  }
+  return true;
+}
+
+template <typename PushCallback>
+void MarkingPrefetchQueue::Flush(PushCallback push) {
+  while (size_ > 0) {
+    push(objects_[head_]);
+    head_ = (head_ + 1) % kMaxDistance;
+    size_--;
+  }
+  head_ = 0;
+}
+
 }  // namespace internal
 }  // namespace v8
 
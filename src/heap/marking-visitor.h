@@ -5,6 +5,8 @@
 #ifndef V8_HEAP_MARKING_VISITOR_H_
 #define V8_HEAP_MARKING_VISITOR_H_
 
+#include <algorithm>
+
 #include "src/common/globals.h"
 #include "src/heap/marking-worklist.h"
 #include "src/heap/marking.h"
@@ -83,6 +85,49 @@ class MarkingStateBase {
   }
 };
 
+// A FIFO ring of objects that were popped from the marking worklist but are
+// not visited yet. Objects are prefetched when they enter the ring and the
+// map of the next object is prefetched when an object leaves it, so that the
+// cache misses of up to |distance| objects overlap with visiting. Used by the
+// main thread and the concurrent markers if --marking-prefetch-distance is
+// set. With a distance of 0 all calls forward to the worklist.
+//
+// The ring is private to a marker, so pending objects have to be flushed
+// back to the worklist before the marker publishes its work or stops.
+class MarkingPrefetchQueue final {
+ public:
+  static const int kMaxDistance = 16;
+
+  explicit MarkingPrefetchQueue(int distance)
+      : distance_(std::max(0, std::min(distance, kMaxDistance))) {}
+  MarkingPrefetchQueue(const MarkingPrefetchQueue&) = delete;
+  MarkingPrefetchQueue& operator=(const MarkingPrefetchQueue&) = delete;
+  ~MarkingPrefetchQueue() { DCHECK(IsEmpty()); }
+
+  // Fills the ring from |pop|, which has the signature bool(HeapObject*), and
+  // returns the oldest pending object in |object|. Returns false if both the
+  // ring and the worklist are empty.
+  template <typename PopCallback>
+  V8_INLINE bool Pop(PopCallback pop, HeapObject* object);
+
+  // Hands all pending objects to |push|, which has the signature
+  // void(HeapObject), in FIFO order.
+  template <typename PushCallback>
+  V8_INLINE void Flush(PushCallback push);
+
+  bool IsEmpty() const { return size_ == 0; }
+  int size() const { return size_; }
+  int distance() const { return distance_; }
+
+ private:
+  V8_INLINE static void Prefetch(Address address);
+
+  const int distance_;
+  int head_ = 0;
+  int size_ = 0;
+  HeapObject objects_[kMaxDistance];
+};
+
 // The base class for all marking visitors. It implements marking logic with
 // support of bytecode flushing, embedder tracing, weak and references.
 //
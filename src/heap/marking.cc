@@ -4,11 +4,53 @@
 
 #include "src/heap/marking.h"
 
+#include <cstring>
+
+#include "src/base/bits.h"
+#include "src/base/build_config.h"
+
+// SSE2 is part of the x64 baseline, so no runtime CPU check is needed.
+#if V8_HOST_ARCH_X64 || (V8_HOST_ARCH_IA32 && defined(__SSE2__))
+#define V8_BITMAP_SCAN_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace v8 {
 namespace internal {
 
 const size_t Bitmap::kSize = Bitmap::CellsCount() * Bitmap::kBytesPerCell;
 
+// static
+uint32_t Bitmap::FindNonZeroCell(const MarkBit::CellType* cells,
+                                 uint32_t start_cell, uint32_t end_cell) {
+  uint32_t i = start_cell;
+#ifdef V8_BITMAP_SCAN_SSE2
+  static const uint32_t kCellsPerVector = sizeof(__m128i) / kBytesPerCell;
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + kCellsPerVector <= end_cell; i += kCellsPerVector) {
+    __m128i vector =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + i));
+    // One bit per byte, set for bytes of cells that are zero.
+    uint32_t zero_bytes = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi32(vector, zero)));
+    if (zero_bytes != 0xFFFF) {
+      return i + base::bits::CountTrailingZeros(~zero_bytes) / kBytesPerCell;
+    }
+  }
+#else
+  static const uint32_t kCellsPerWord = sizeof(uint64_t) / kBytesPerCell;
+  for (; i + kCellsPerWord <= end_cell; i += kCellsPerWord) {
+    uint64_t word;
+    memcpy(&word, cells + i, sizeof(word));
+    if (word != 0) break;
+  }
+#endif
+  for (; i < end_cell; i++) {
+    if (cells[i] != 0) return i;
+  }
+  return end_cell;
+}
+
 template <>
 bool ConcurrentBitmap<AccessMode::NON_ATOMIC>::AllBitsSetInRange(
     uint32_t start_index, uint32_t end_index) {
@@ -54,8 +96,9 @@ bool ConcurrentBitmap<AccessMode::NON_ATOMIC>::AllBitsClearInRange(
   if (start_cell_index != end_cell_index) {
     matching_mask = ~(start_index_mask - 1);
     if ((cells()[start_cell_index] & matching_mask)) return false;
-    for (unsigned int i = start_cell_index + 1; i < end_cell_index; i++) {
-      if (cells()[i]) return false;
+    if (FindNonZeroCell(cells(), start_cell_index + 1, end_cell_index) !=
+        end_cell_index) {
+      return false;
     }
     matching_mask = end_index_mask | (end_index_mask - 1);
     return !(cells()[end_cell_index] & matching_mask);
@@ -129,12 +172,7 @@ void ConcurrentBitmap<AccessMode::NON_ATOMIC>::Print() {
 
 template <>
 bool ConcurrentBitmap<AccessMode::NON_ATOMIC>::IsClean() {
-  for (size_t i = 0; i < CellsCount(); i++) {
-    if (cells()[i] != 0) {
-      return false;
-    }
-  }
-  return true;
+  return FindNonZeroCell(cells(), 0, CellsCount()) == CellsCount();
 }
 
 }  // namespace internal
@@ -138,6 +138,12 @@ class V8_EXPORT_PRIVATE Bitmap {
     MarkBit::CellType* cell = this->cells() + (index >> kBitsPerCellLog2);
     return MarkBit(cell, mask);
   }
+
+  // Returns the index of the first non-zero cell in [start_cell, end_cell), or
+  // end_cell if all of them are zero. Uses 128-bit vector compares where SSE2
+  // is available and 64-bit words otherwise.
+  static uint32_t FindNonZeroCell(const MarkBit::CellType* cells,
+                                  uint32_t start_cell, uint32_t end_cell);
 };
 
 template <AccessMode mode>
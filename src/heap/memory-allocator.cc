@@ -5,14 +5,17 @@
 #include "src/heap/memory-allocator.h"
 
 #include <cinttypes>
+#include <unordered_map>
 
 #include "src/base/address-region.h"
+#include "src/base/platform/platform.h"
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
 #include "src/flags/flags.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/memory-chunk.h"
+#include "src/heap/paged-spaces.h"
 #include "src/heap/read-only-spaces.h"
 #include "src/logging/log.h"
 #include "src/utils/allocation.h"
@@ -23,6 +26,15 @@ namespace internal {
 static base::LazyInstance<CodeRangeAddressHint>::type code_range_address_hint =
     LAZY_INSTANCE_INITIALIZER;
 
+namespace {
+
+bool PackForHugePages(BaseSpace* owner) {
+  return FLAG_huge_pages_for_old_space && owner != nullptr &&
+         (owner->identity() == OLD_SPACE || owner->identity() == CODE_SPACE);
+}
+
+}  // namespace
+
 Address CodeRangeAddressHint::GetAddressHint(size_t code_range_size) {
   base::MutexGuard guard(&mutex_);
   auto it = recently_freed_.find(code_range_size);
@@ -54,6 +66,8 @@ MemoryAllocator::MemoryAllocator(Isolate* isolate, size_t capacity,
       size_executable_(0),
       lowest_ever_allocated_(static_cast<Address>(-1ll)),
       highest_ever_allocated_(kNullAddress),
+      next_data_chunk_hint_(kNullAddress),
+      next_code_chunk_hint_(kNullAddress),
       unmapper_(isolate->heap(), this) {
   InitializeCodePageAllocator(data_page_allocator_, code_range_size);
 }
@@ -223,6 +237,8 @@ void MemoryAllocator::Unmapper::CancelAndWaitForPendingTasks() {
 }
 
 void MemoryAllocator::Unmapper::PrepareForGC() {
+  // The GC may free or shrink chunks whose tails are still queued.
+  PerformPartialFreeOnQueuedChunks();
   // Free non-regular chunks because they cannot be re-used.
   PerformFreeMemoryOnQueuedNonRegularChunks();
 }
@@ -241,6 +257,18 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedNonRegularChunks(
   }
 }
 
+void MemoryAllocator::Unmapper::PerformPartialFreeOnQueuedChunks(
+    JobDelegate* delegate) {
+  while (true) {
+    base::MutexGuard guard(&mutex_);
+    if (partial_frees_.empty()) return;
+    std::pair<BasicMemoryChunk*, Address> partial_free = partial_frees_.back();
+    partial_frees_.pop_back();
+    allocator_->ReleaseChunkTail(partial_free.first, partial_free.second);
+    if (delegate && delegate->ShouldYield()) return;
+  }
+}
+
 template <MemoryAllocator::Unmapper::FreeMode mode>
 void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
     JobDelegate* delegate) {
@@ -251,6 +279,8 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
         "Unmapper::PerformFreeMemoryOnQueuedChunks: %d queued chunks\n",
         NumberOfChunks());
   }
+  PerformPartialFreeOnQueuedChunks(delegate);
+  if (delegate && delegate->ShouldYield()) return;
   // Regular chunks.
   while ((chunk = GetMemoryChunkSafe<kRegular>()) != nullptr) {
     bool pooled = chunk->IsFlagSet(MemoryChunk::POOLED);
@@ -276,11 +306,13 @@ void MemoryAllocator::Unmapper::TearDown() {
   for (int i = 0; i < kNumberOfChunkQueues; i++) {
     DCHECK(chunks_[i].empty());
   }
+  DCHECK(partial_frees_.empty());
 }
 
 size_t MemoryAllocator::Unmapper::NumberOfCommittedChunks() {
   base::MutexGuard guard(&mutex_);
-  return chunks_[kRegular].size() + chunks_[kNonRegular].size();
+  return chunks_[kRegular].size() + chunks_[kNonRegular].size() +
+         partial_frees_.size();
 }
 
 int MemoryAllocator::Unmapper::NumberOfChunks() {
@@ -378,8 +410,7 @@ V8_EXPORT_PRIVATE BasicMemoryChunk* MemoryAllocator::AllocateBasicChunk(
   VirtualMemory reservation;
   Address area_start = kNullAddress;
   Address area_end = kNullAddress;
-  void* address_hint =
-      AlignedAddress(heap->GetRandomMmapAddr(), MemoryChunk::kAlignment);
+  void* address_hint = ChunkAddressHint(owner, executable);
 
   //
   // MemoryChunk layout:
@@ -485,9 +516,56 @@ V8_EXPORT_PRIVATE BasicMemoryChunk* MemoryAllocator::AllocateBasicChunk(
       BasicMemoryChunk::Initialize(heap, base, chunk_size, area_start, area_end,
                                    owner, std::move(reservation));
 
+  if (PackForHugePages(owner)) AdviseHugePages(chunk, executable);
+
   return chunk;
 }
 
+void* MemoryAllocator::ChunkAddressHint(BaseSpace* owner,
+                                        Executability executable) {
+  Heap* heap = isolate_->heap();
+  if (!PackForHugePages(owner)) {
+    return AlignedAddress(heap->GetRandomMmapAddr(), MemoryChunk::kAlignment);
+  }
+  Address hint = executable == EXECUTABLE ? next_code_chunk_hint_.load()
+                                          : next_data_chunk_hint_.load();
+  if (hint != kNullAddress) return reinterpret_cast<void*>(hint);
+  // Start a fresh huge page region. Subsequent chunks are placed right behind
+  // this one so that the region fills up densely.
+  return AlignedAddress(heap->GetRandomMmapAddr(), kHugePageSize);
+}
+
+void MemoryAllocator::AdviseHugePages(BasicMemoryChunk* chunk,
+                                      Executability executable) {
+  Address end = chunk->address() + chunk->size();
+  if (executable == EXECUTABLE) {
+    next_code_chunk_hint_ = end;
+  } else {
+    next_data_chunk_hint_ = end;
+  }
+  // The hint is best effort; the OS may still fall back to regular pages.
+  USE(base::OS::AdviseHugePages(reinterpret_cast<void*>(chunk->address()),
+                                chunk->size()));
+}
+
+// static
+size_t MemoryAllocator::HugePageCoveredBytes(PagedSpace* space) {
+  // Regular pages are kAlignment-aligned and never straddle a huge page
+  // region, so summing page sizes per region tells whether it is fully
+  // populated.
+  STATIC_ASSERT(kHugePageSize % MemoryChunk::kAlignment == 0);
+  std::unordered_map<Address, size_t> bytes_per_region;
+  for (Page* page : *space) {
+    bytes_per_region[RoundDown(page->address(), kHugePageSize)] +=
+        page->size();
+  }
+  size_t covered_bytes = 0;
+  for (const auto& entry : bytes_per_region) {
+    if (entry.second >= kHugePageSize) covered_bytes += entry.second;
+  }
+  return covered_bytes;
+}
+
 MemoryChunk* MemoryAllocator::AllocateChunk(size_t reserve_area_size,
                                             size_t commit_area_size,
                                             Executability executable,
@@ -508,6 +586,20 @@ void MemoryAllocator::PartialFreeMemory(BasicMemoryChunk* chunk,
                                         Address start_free,
                                         size_t bytes_to_free,
                                         Address new_area_end) {
+  ShrinkChunk(chunk, bytes_to_free, new_area_end);
+  ReleaseChunkTail(chunk, start_free);
+}
+
+void MemoryAllocator::PartialFreeMemoryConcurrently(BasicMemoryChunk* chunk,
+                                                    Address start_free,
+                                                    size_t bytes_to_free,
+                                                    Address new_area_end) {
+  ShrinkChunk(chunk, bytes_to_free, new_area_end);
+  unmapper()->AddPartialFreeSafe(chunk, start_free);
+}
+
+void MemoryAllocator::ShrinkChunk(BasicMemoryChunk* chunk,
+                                  size_t bytes_to_free, Address new_area_end) {
   VirtualMemory* reservation = chunk->reserved_memory();
   DCHECK(reservation->IsReserved());
   chunk->set_size(chunk->size() - bytes_to_free);
@@ -521,6 +613,11 @@ void MemoryAllocator::PartialFreeMemory(BasicMemoryChunk* chunk,
     reservation->SetPermissions(chunk->area_end(), page_size,
                                 PageAllocator::kNoAccess);
   }
+}
+
+void MemoryAllocator::ReleaseChunkTail(BasicMemoryChunk* chunk,
+                                       Address start_free) {
+  VirtualMemory* reservation = chunk->reserved_memory();
   // On e.g. Windows, a reservation may be larger than a page and releasing
   // partially starting at |start_free| will also release the potentially
   // unused part behind the current page.
@@ -94,6 +94,13 @@ class MemoryAllocator {
       return chunk;
     }
 
+    // Queues the release of the memory of |chunk| starting at |start_free|.
+    // The chunk header has already been shrunk by the caller.
+    void AddPartialFreeSafe(BasicMemoryChunk* chunk, Address start_free) {
+      base::MutexGuard guard(&mutex_);
+      partial_frees_.emplace_back(chunk, start_free);
+    }
+
     V8_EXPORT_PRIVATE void FreeQueuedChunks();
     void CancelAndWaitForPendingTasks();
     void PrepareForGC();
@@ -143,10 +150,16 @@ class MemoryAllocator {
     void PerformFreeMemoryOnQueuedNonRegularChunks(
         JobDelegate* delegate = nullptr);
 
+    // Releases the tails of all chunks queued by AddPartialFreeSafe. The
+    // mutex is held while releasing, so that no release is in flight when the
+    // main thread returns from PrepareForGC.
+    void PerformPartialFreeOnQueuedChunks(JobDelegate* delegate = nullptr);
+
     Heap* const heap_;
     MemoryAllocator* const allocator_;
     base::Mutex mutex_;
     std::vector<MemoryChunk*> chunks_[kNumberOfChunkQueues];
+    std::vector<std::pair<BasicMemoryChunk*, Address>> partial_frees_;
     std::unique_ptr<v8::JobHandle> job_handle_;
 
     friend class MemoryAllocator;
@@ -166,6 +179,15 @@ class MemoryAllocator {
 
   V8_EXPORT_PRIVATE static intptr_t GetCommitPageSize();
 
+  // Size of a transparent huge page. With --huge-pages-for-old-space, old and
+  // code space pages are packed into regions of this size.
+  static constexpr size_t kHugePageSize = 2 * MB;
+
+  // Returns the number of bytes of |space| that lie in kHugePageSize-aligned
+  // regions fully populated by its pages, i.e. that can be backed by huge
+  // pages.
+  V8_EXPORT_PRIVATE static size_t HugePageCoveredBytes(PagedSpace* space);
+
   // Computes the memory area of discardable memory within a given memory area
   // [addr, addr+size) and returns the result as base::AddressRegion. If the
   // memory is not discardable base::AddressRegion is an empty region.
@@ -245,6 +267,12 @@ class MemoryAllocator {
   void PartialFreeMemory(BasicMemoryChunk* chunk, Address start_free,
                          size_t bytes_to_free, Address new_area_end);
 
+  // Like PartialFreeMemory, but only shrinks the chunk header and leaves
+  // releasing the memory to the Unmapper, which does so concurrently.
+  void PartialFreeMemoryConcurrently(BasicMemoryChunk* chunk,
+                                     Address start_free, size_t bytes_to_free,
+                                     Address new_area_end);
+
   // Checks if an allocated MemoryChunk was intended to be used for executable
   // memory.
   bool IsMemoryChunkExecutable(MemoryChunk* chunk) {
@@ -309,6 +337,22 @@ class MemoryAllocator {
   void InitializeCodePageAllocator(v8::PageAllocator* page_allocator,
                                    size_t requested);
 
+  // Shrinks the header of |chunk| for a partial free.
+  void ShrinkChunk(BasicMemoryChunk* chunk, size_t bytes_to_free,
+                   Address new_area_end);
+
+  // Releases the memory of |chunk| starting at |start_free|.
+  void ReleaseChunkTail(BasicMemoryChunk* chunk, Address start_free);
+
+  // Returns the address hint for a new chunk of |owner|. Old and code space
+  // chunks are packed behind the previously allocated one when huge pages are
+  // requested, everything else is placed randomly.
+  void* ChunkAddressHint(BaseSpace* owner, Executability executable);
+
+  // Records |chunk| as the last packed chunk and advises the OS to back it with
+  // huge pages.
+  void AdviseHugePages(BasicMemoryChunk* chunk, Executability executable);
+
   // PreFreeMemory logically frees the object, i.e., it unregisters the
   // memory, logs a delete event and adds the chunk to remembered unmapped
   // pages.
@@ -410,6 +454,11 @@ class MemoryAllocator {
   std::atomic<Address> lowest_ever_allocated_;
   std::atomic<Address> highest_ever_allocated_;
 
+  // End of the last packed old and code space chunk respectively. Only used
+  // as address hints for --huge-pages-for-old-space.
+  std::atomic<Address> next_data_chunk_hint_;
+  std::atomic<Address> next_code_chunk_hint_;
+
   VirtualMemory last_chunk_;
   Unmapper unmapper_;
 
@@ -270,6 +270,17 @@ void SemiSpace::MovePageToTheEnd(Page* page) {
   current_page_ = page;
 }
 
+Page* SemiSpace::ClaimPageBeforeCurrent() {
+  Page* next_page = current_page_->next_page();
+  if (next_page == nullptr || current_capacity_ == target_capacity_) {
+    return nullptr;
+  }
+  memory_chunk_list_.Remove(next_page);
+  memory_chunk_list_.InsertBefore(next_page, current_page_);
+  current_capacity_ += Page::kPageSize;
+  return next_page;
+}
+
 void SemiSpace::Swap(SemiSpace* from, SemiSpace* to) {
   // We won't be swapping semispaces without data in them.
   DCHECK(from->first_page());
@@ -429,12 +440,15 @@ void NewSpace::ResetParkedAllocationBuffers() {
 void NewSpace::Flip() { SemiSpace::Swap(&from_space_, &to_space_); }
 
 void NewSpace::Grow() {
-  DCHECK_IMPLIES(FLAG_local_heaps, heap()->safepoint()->IsActive());
   // Double the semispace size but only up to maximum capacity.
   DCHECK(TotalCapacity() < MaximumCapacity());
-  size_t new_capacity = std::min(
-      MaximumCapacity(),
-      static_cast<size_t>(FLAG_semi_space_growth_factor) * TotalCapacity());
+  GrowTo(static_cast<size_t>(FLAG_semi_space_growth_factor) * TotalCapacity());
+}
+
+void NewSpace::GrowTo(size_t new_capacity) {
+  DCHECK_IMPLIES(FLAG_local_heaps, heap()->safepoint()->IsActive());
+  new_capacity = std::min(MaximumCapacity(), new_capacity);
+  if (new_capacity <= TotalCapacity()) return;
   if (to_space_.GrowTo(new_capacity)) {
     // Only grow from space if we managed to grow to-space.
     if (!from_space_.GrowTo(new_capacity)) {
@@ -446,8 +460,10 @@ void NewSpace::Grow() {
   DCHECK_SEMISPACE_ALLOCATION_INFO(allocation_info_, to_space_);
 }
 
-void NewSpace::Shrink() {
-  size_t new_capacity = std::max(InitialTotalCapacity(), 2 * Size());
+void NewSpace::Shrink() { ShrinkTo(InitialTotalCapacity()); }
+
+void NewSpace::ShrinkTo(size_t new_capacity) {
+  new_capacity = std::max({new_capacity, InitialTotalCapacity(), 2 * Size()});
   size_t rounded_new_capacity = ::RoundUp(new_capacity, Page::kPageSize);
   if (rounded_new_capacity < TotalCapacity()) {
     to_space_.ShrinkTo(rounded_new_capacity);
@@ -480,6 +496,7 @@ void NewSpace::UpdateLinearAllocationArea(Address known_top) {
 }
 
 void NewSpace::ResetLinearAllocationArea() {
+  FreeBackgroundLinearAllocationArea();
   to_space_.Reset();
   UpdateLinearAllocationArea();
   // Clear all mark-bits in the to-space.
@@ -573,12 +590,20 @@ bool NewSpace::EnsureAllocation(int size_in_bytes,
     return true;
   }
 
-  // Not enough room in the page, try to allocate a new one.
-  if (!AddFreshPage()) {
-    // When we cannot grow NewSpace anymore we query for parked allocations.
-    if (!FLAG_allocation_buffer_parking ||
-        !AddParkedAllocationBuffer(size_in_bytes, alignment))
-      return false;
+  {
+    // Background threads may claim to-space pages concurrently.
+    base::Optional<base::MutexGuard> guard;
+    if (FLAG_concurrent_new_space_allocation) {
+      guard.emplace(&background_allocation_mutex_);
+    }
+
+    // Not enough room in the page, try to allocate a new one.
+    if (!AddFreshPage()) {
+      // When we cannot grow NewSpace anymore we query for parked allocations.
+      if (!FLAG_allocation_buffer_parking ||
+          !AddParkedAllocationBuffer(size_in_bytes, alignment))
+        return false;
+    }
   }
 
   old_top = allocation_info_.top();
@@ -591,6 +616,49 @@ bool NewSpace::EnsureAllocation(int size_in_bytes,
   return true;
 }
 
+base::Optional<std::pair<Address, size_t>> NewSpace::RawRefillLabBackground(
+    size_t min_size_in_bytes, size_t max_size_in_bytes,
+    AllocationAlignment alignment) {
+  DCHECK(FLAG_concurrent_new_space_allocation);
+  DCHECK_LE(min_size_in_bytes, max_size_in_bytes);
+  base::MutexGuard guard(&background_allocation_mutex_);
+
+  Address top = background_allocation_info_.top();
+  Address limit = background_allocation_info_.limit();
+  int filler_size = Heap::GetFillToAlign(top, alignment);
+  if (top == kNullAddress ||
+      top + filler_size + min_size_in_bytes > limit) {
+    // The remainder of the current page already holds a filler object.
+    Page* page = to_space_.ClaimPageBeforeCurrent();
+    if (page == nullptr) return {};
+    top = page->area_start();
+    limit = page->area_end();
+    filler_size = Heap::GetFillToAlign(top, alignment);
+  }
+
+  if (filler_size > 0) {
+    heap()->CreateFillerObjectAtBackground(
+        top, filler_size, ClearFreedMemoryMode::kDontClearFreedMemory);
+    top += filler_size;
+  }
+  size_t lab_size =
+      std::min(max_size_in_bytes, static_cast<size_t>(limit - top));
+  DCHECK_GE(lab_size, min_size_in_bytes);
+  Address new_top = top + lab_size;
+  if (new_top < limit) {
+    heap()->CreateFillerObjectAtBackground(
+        new_top, static_cast<int>(limit - new_top),
+        ClearFreedMemoryMode::kDontClearFreedMemory);
+  }
+  background_allocation_info_.Reset(new_top, limit);
+  return std::make_pair(top, lab_size);
+}
+
+void NewSpace::FreeBackgroundLinearAllocationArea() {
+  // The remainder is already iterable, so it is enough to drop it.
+  background_allocation_info_.Reset(kNullAddress, kNullAddress);
+}
+
 void NewSpace::MaybeFreeUnusedLab(LinearAllocationArea info) {
   if (info.limit() != kNullAddress && info.limit() == top()) {
     DCHECK_NE(info.top(), kNullAddress);
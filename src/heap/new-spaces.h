@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "src/base/macros.h"
+#include "src/base/optional.h"
 #include "src/base/platform/mutex.h"
 #include "src/common/globals.h"
 #include "src/heap/heap.h"
@@ -107,6 +108,11 @@ class SemiSpace : public Space {
   void PrependPage(Page* page);
   void MovePageToTheEnd(Page* page);
 
+  // Takes the page following the current page and moves it in front of the
+  // current page, so that it lies below the allocation top and is covered by
+  // iteration. Returns nullptr if the capacity of the space is exhausted.
+  Page* ClaimPageBeforeCurrent();
+
   Page* InitializePage(MemoryChunk* chunk);
 
   // Age mark accessors.
@@ -254,15 +260,25 @@ class V8_EXPORT_PRIVATE NewSpace
   // their maximum capacity.
   void Grow();
 
+  // Grow the capacity of the semispaces to |new_capacity|, bounded by their
+  // maximum capacity.
+  void GrowTo(size_t new_capacity);
+
   // Shrink the capacity of the semispaces.
   void Shrink();
 
+  // Shrink the capacity of the semispaces towards |new_capacity|. The
+  // capacity never drops below the initial capacity or twice the current
+  // size.
+  void ShrinkTo(size_t new_capacity);
+
   // Return the allocated bytes in the active semispace.
   size_t Size() final {
-    DCHECK_GE(top(), to_space_.page_low());
-    return (to_space_.current_capacity() - Page::kPageSize) / Page::kPageSize *
-               MemoryChunkLayout::AllocatableMemoryInDataPage() +
-           static_cast<size_t>(top() - to_space_.page_low());
+    base::Optional<base::MutexGuard> guard;
+    if (FLAG_concurrent_new_space_allocation) {
+      guard.emplace(&background_allocation_mutex_);
+    }
+    return SizeLocked();
   }
 
   size_t SizeOfObjects() final { return Size(); }
@@ -318,6 +334,11 @@ class V8_EXPORT_PRIVATE NewSpace
   }
 
   size_t AllocatedSinceLastGC() {
+    // Background threads may claim to-space pages concurrently.
+    base::Optional<base::MutexGuard> guard;
+    if (FLAG_concurrent_new_space_allocation) {
+      guard.emplace(&background_allocation_mutex_);
+    }
     const Address age_mark = to_space_.age_mark();
     DCHECK_NE(age_mark, kNullAddress);
     DCHECK_NE(top(), kNullAddress);
@@ -341,7 +362,7 @@ class V8_EXPORT_PRIVATE NewSpace
     }
     DCHECK_GE(top(), current_page->area_start());
     allocated += top() - current_page->area_start();
-    DCHECK_LE(allocated, Size());
+    DCHECK_LE(allocated, SizeLocked());
     return allocated;
   }
 
@@ -393,6 +414,17 @@ class V8_EXPORT_PRIVATE NewSpace
       int size_in_bytes, AllocationAlignment alignment,
       AllocationOrigin origin = AllocationOrigin::kRuntime);
 
+  // Allocates a LAB for a background thread. The LAB is carved out of pages
+  // that are claimed from the to-space and are not used by the main thread's
+  // linear allocation area. Returns the start address and size of the LAB.
+  V8_EXPORT_PRIVATE base::Optional<std::pair<Address, size_t>>
+  RawRefillLabBackground(size_t min_size_in_bytes, size_t max_size_in_bytes,
+                         AllocationAlignment alignment);
+
+  // Gives up the page that background LABs are currently carved from. Needs
+  // to be called in a safepoint before the to-space is flipped or reset.
+  void FreeBackgroundLinearAllocationArea();
+
   // Reset the allocation pointer to the beginning of the active semispace.
   void ResetLinearAllocationArea();
 
@@ -470,8 +502,25 @@ class V8_EXPORT_PRIVATE NewSpace
   // Update linear allocation area to match the current to-space page.
   void UpdateLinearAllocationArea(Address known_top = 0);
 
+  // Like Size(), but expects background_allocation_mutex_ to be held if
+  // background threads may claim to-space pages.
+  size_t SizeLocked() {
+    DCHECK_GE(top(), to_space_.page_low());
+    return (to_space_.current_capacity() - Page::kPageSize) / Page::kPageSize *
+               MemoryChunkLayout::AllocatableMemoryInDataPage() +
+           static_cast<size_t>(top() - to_space_.page_low());
+  }
+
   base::Mutex mutex_;
 
+  // Protects the to-space page list and its current capacity against
+  // concurrent updates from the main thread and from background threads
+  // refilling their LABs. Readers of either on the main thread take it too.
+  base::Mutex background_allocation_mutex_;
+  // The remainder of the page that background LABs are carved from. The area
+  // between top and limit always holds a filler object.
+  LinearAllocationArea background_allocation_info_;
+
   // The top and the limit at the time of setting the linear allocation area.
   // These values can be accessed by background tasks.
   std::atomic<Address> original_top_;
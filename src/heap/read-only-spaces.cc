@@ -9,6 +9,7 @@
 #include "include/v8-internal.h"
 #include "include/v8-platform.h"
 #include "src/base/logging.h"
+#include "src/base/platform/platform.h"
 #include "src/common/globals.h"
 #include "src/common/ptr-compr-inl.h"
 #include "src/execution/isolate.h"
@@ -389,6 +390,21 @@ void ReadOnlySpace::Seal(SealMode ro_mode) {
   }
 
   SetPermissionsForPages(memory_allocator, PageAllocator::kRead);
+
+  // Sealed pages only have identical contents in processes started from the
+  // same snapshot if they also agree on the hash seed, since strings from the
+  // snapshot are rehashed with a randomized seed, and if pointers are
+  // compressed, since full pointers into the space differ under ASLR. Page
+  // headers always differ, so the OS page holding them stays private.
+  const bool contents_are_process_independent =
+      COMPRESS_POINTERS_BOOL &&
+      (FLAG_hash_seed != 0 || !FLAG_rehash_snapshot);
+  if (FLAG_mergeable_read_only_pages && contents_are_process_independent) {
+    for (BasicMemoryChunk* chunk : pages_) {
+      void* address = reinterpret_cast<void*>(chunk->address());
+      USE(base::OS::MakePagesMergeable(address, chunk->size()));
+    }
+  }
 }
 
 void ReadOnlySpace::Unseal() {
@@ -0,0 +1,117 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/remembered-set-filter.h"
+
+#include <algorithm>
+
+#include "src/heap/heap-inl.h"
+#include "src/heap/memory-chunk.h"
+#include "src/heap/paged-spaces-inl.h"
+#include "src/heap/read-only-spaces.h"
+#include "src/heap/remembered-set.h"
+#include "src/init/v8.h"
+#include "src/objects/slots-inl.h"
+
+namespace v8 {
+namespace internal {
+
+class RememberedSetFilter::JobTask : public v8::JobTask {
+ public:
+  explicit JobTask(RememberedSetFilter* filter) : filter_(filter) {}
+
+  void Run(JobDelegate* delegate) override { filter_->Run(delegate); }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    return filter_->GetMaxConcurrency(worker_count);
+  }
+
+ private:
+  RememberedSetFilter* const filter_;
+};
+
+RememberedSetFilter::RememberedSetFilter(Heap* heap) : heap_(heap) {}
+
+RememberedSetFilter::~RememberedSetFilter() { DCHECK(!IsRunning()); }
+
+void RememberedSetFilter::Start() {
+  DCHECK(!IsRunning());
+  chunks_.clear();
+  old_chunks_.clear();
+  next_chunk_.store(0, std::memory_order_relaxed);
+  slots_removed_.store(0, std::memory_order_relaxed);
+
+  OldGenerationMemoryChunkIterator it(heap_);
+  MemoryChunk* chunk;
+  while ((chunk = it.next()) != nullptr) {
+    old_chunks_.insert(chunk->address());
+    // Code pages may be write protected and rarely have old-to-new slots.
+    if (chunk->owner_identity() == CODE_SPACE ||
+        chunk->owner_identity() == CODE_LO_SPACE) {
+      continue;
+    }
+    // The sweeper owns the slot sets of unswept pages, and sweeping slot sets
+    // are merged into the regular slot set concurrently on refill.
+    if (!chunk->SweepingDone() ||
+        chunk->sweeping_slot_set<AccessMode::NON_ATOMIC>() != nullptr) {
+      continue;
+    }
+    if (chunk->slot_set<OLD_TO_NEW, AccessMode::NON_ATOMIC>() == nullptr) {
+      continue;
+    }
+    chunks_.push_back(chunk);
+  }
+  for (ReadOnlyPage* page : heap_->read_only_space()->pages()) {
+    old_chunks_.insert(page->address());
+  }
+  if (chunks_.empty()) return;
+
+  job_handle_ = V8::GetCurrentPlatform()->PostJob(
+      TaskPriority::kBestEffort, std::make_unique<JobTask>(this));
+}
+
+void RememberedSetFilter::Stop() {
+  if (!IsRunning()) return;
+  job_handle_->Cancel();
+}
+
+void RememberedSetFilter::RunToCompletionForTesting() {
+  Stop();
+  Run(nullptr);
+}
+
+void RememberedSetFilter::Run(JobDelegate* delegate) {
+  while (delegate == nullptr || !delegate->ShouldYield()) {
+    size_t index = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= chunks_.size()) return;
+    size_t removed = FilterChunk(chunks_[index]);
+    slots_removed_.fetch_add(removed, std::memory_order_relaxed);
+  }
+}
+
+size_t RememberedSetFilter::FilterChunk(MemoryChunk* chunk) {
+  return RememberedSet<OLD_TO_NEW>::FilterConcurrently(
+      chunk, [this](MaybeObjectSlot slot) {
+        return IsStale(slot) ? REMOVE_SLOT : KEEP_SLOT;
+      });
+}
+
+bool RememberedSetFilter::IsStale(MaybeObjectSlot slot) const {
+  MaybeObject object = slot.Relaxed_Load();
+  HeapObject heap_object;
+  if (!object->GetHeapObject(&heap_object)) return true;
+  // Objects on chunks that were allocated after Start() are kept
+  // conservatively.
+  return old_chunks_.count(BasicMemoryChunk::BaseAddress(heap_object.ptr())) !=
+         0;
+}
+
+size_t RememberedSetFilter::GetMaxConcurrency(size_t worker_count) const {
+  size_t next = std::min(next_chunk_.load(std::memory_order_relaxed),
+                         chunks_.size());
+  return std::min<size_t>(kMaxTasks, chunks_.size() - next);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,82 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_REMEMBERED_SET_FILTER_H_
+#define V8_HEAP_REMEMBERED_SET_FILTER_H_
+
+#include <atomic>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "include/v8-platform.h"
+#include "src/common/globals.h"
+#include "src/objects/slots.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class MemoryChunk;
+
+// Removes stale old-to-new slots on background threads between GCs. A slot is
+// stale if it holds a Smi, a cleared weak reference, or a pointer into the old
+// generation. Scavenges after pretenuring or after large arrays were
+// overwritten with old objects then visit far fewer slots.
+//
+// The filter only touches the regular slot sets of swept pages that do not
+// have a sweeping slot set. Nothing else modifies those slot sets until the
+// next GC except the write barrier. The runtime inserts with
+// InsertAndPublish() while filtering is enabled and the RecordWrite builtin
+// sets bits with an atomic or, so neither can lose a bit that the filter
+// clears and sets again. Slot values are never dereferenced. Instead,
+// pointers are classified with a snapshot of the old generation chunks that
+// is taken in the GC pause.
+class V8_EXPORT_PRIVATE RememberedSetFilter final {
+ public:
+  static const int kMaxTasks = 2;
+
+  explicit RememberedSetFilter(Heap* heap);
+  ~RememberedSetFilter();
+  RememberedSetFilter(const RememberedSetFilter&) = delete;
+  RememberedSetFilter& operator=(const RememberedSetFilter&) = delete;
+
+  // Collects the chunks to filter and posts the background job. Must be called
+  // at the end of a GC pause.
+  void Start();
+
+  // Cancels the background job and waits for running workers. Must be called
+  // before the next GC accesses remembered sets.
+  void Stop();
+
+  // Filters the remaining chunks on the calling thread. Exposed for testing.
+  void RunToCompletionForTesting();
+
+  bool IsRunning() const { return job_handle_ && job_handle_->IsValid(); }
+
+  // Number of slots removed since the last Start().
+  size_t slots_removed() const {
+    return slots_removed_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  class JobTask;
+
+  void Run(JobDelegate* delegate);
+  size_t FilterChunk(MemoryChunk* chunk);
+  bool IsStale(MaybeObjectSlot slot) const;
+  size_t GetMaxConcurrency(size_t worker_count) const;
+
+  Heap* const heap_;
+  std::vector<MemoryChunk*> chunks_;
+  std::unordered_set<Address> old_chunks_;
+  std::atomic<size_t> next_chunk_{0};
+  std::atomic<size_t> slots_removed_{0};
+  std::unique_ptr<JobHandle> job_handle_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_REMEMBERED_SET_FILTER_H_
@@ -100,6 +100,17 @@ class RememberedSet : public AllStatic {
     RememberedSetOperations::Insert<access_mode>(slot_set, chunk, slot_addr);
   }
 
+  // Like Insert<AccessMode::ATOMIC>() but safe against a concurrent
+  // FilterConcurrently() on the same chunk. See SlotSet::InsertAndPublish().
+  static void InsertAndPublish(MemoryChunk* chunk, Address slot_addr) {
+    DCHECK(chunk->Contains(slot_addr));
+    SlotSet* slot_set = chunk->slot_set<type, AccessMode::ATOMIC>();
+    if (slot_set == nullptr) {
+      slot_set = chunk->AllocateSlotSet<type>();
+    }
+    slot_set->InsertAndPublish(slot_addr - chunk->address());
+  }
+
   // Given a page and a slot in that page, this function returns true if
   // the remembered set contains the slot.
   static bool Contains(MemoryChunk* chunk, Address slot_addr) {
@@ -178,6 +189,16 @@ class RememberedSet : public AllStatic {
     return RememberedSetOperations::Iterate(slot_set, chunk, callback, mode);
   }
 
+  // Removes slots rejected by the callback while other threads may insert
+  // with InsertAndPublish(). See SlotSet::FilterConcurrently().
+  template <typename Callback>
+  static size_t FilterConcurrently(MemoryChunk* chunk, Callback callback) {
+    SlotSet* slot_set = chunk->slot_set<type, AccessMode::ATOMIC>();
+    if (slot_set == nullptr) return 0;
+    return slot_set->FilterConcurrently(chunk->address(), chunk->buckets(),
+                                        callback);
+  }
+
   template <typename Callback>
   static int IterateAndTrackEmptyBuckets(
       MemoryChunk* chunk, Callback callback,
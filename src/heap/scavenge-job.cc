@@ -7,6 +7,8 @@
 #include "src/base/platform/time.h"
 #include "src/execution/isolate.h"
 #include "src/execution/vm-state-inl.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-controller.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap.h"
 #include "src/init/v8.h"
@@ -30,7 +32,18 @@ class ScavengeJob::Task : public CancelableTask {
 };
 
 size_t ScavengeJob::YoungGenerationTaskTriggerSize(Heap* heap) {
-  return heap->new_space()->Capacity() * FLAG_scavenge_task_trigger / 100;
+  size_t trigger =
+      heap->new_space()->Capacity() * FLAG_scavenge_task_trigger / 100;
+  if (heap->pause_budget_in_ms() > 0) {
+    // Scavenge early enough for the expected pause to fit into the budget.
+    const size_t budget_size = NewSpaceController::MaxCapacityForPause(
+        heap->tracer()->AverageSurvivalRatio(),
+        heap->tracer()->ScavengeSpeedInBytesPerMillisecond(
+            kForSurvivedObjects),
+        heap->pause_budget_in_ms());
+    trigger = std::min(trigger, std::max(budget_size, kMinTaskTriggerSize));
+  }
+  return trigger;
 }
 
 bool ScavengeJob::YoungGenerationSizeTaskTriggerReached(Heap* heap) {
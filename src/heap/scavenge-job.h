@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_SCAVENGE_JOB_H_
 #define V8_HEAP_SCAVENGE_JOB_H_
 
+#include "src/common/globals.h"
 #include "src/tasks/cancelable-task.h"
 
 namespace v8 {
@@ -21,9 +22,13 @@ class ScavengeJob {
 
   void ScheduleTaskIfNeeded(Heap* heap);
 
-  static size_t YoungGenerationTaskTriggerSize(Heap* heap);
+  V8_EXPORT_PRIVATE static size_t YoungGenerationTaskTriggerSize(Heap* heap);
 
  private:
+  // Lower bound for the trigger size when it is derived from the pause
+  // budget, to avoid posting a task for every allocated page.
+  static constexpr size_t kMinTaskTriggerSize = 1 * MB;
+
   class Task;
 
   static bool YoungGenerationSizeTaskTriggerReached(Heap* heap);
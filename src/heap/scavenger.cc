@@ -16,6 +16,7 @@
 #include "src/heap/remembered-set-inl.h"
 #include "src/heap/scavenger-inl.h"
 #include "src/heap/sweeper.h"
+#include "src/logging/counters.h"
 #include "src/objects/data-handler-inl.h"
 #include "src/objects/embedder-data-array-inl.h"
 #include "src/objects/objects-body-descriptors-inl.h"
@@ -377,6 +378,13 @@ void ScavengerCollector::CollectGarbage() {
     }
   }
 
+  isolate_->counters()->gc_scavenger_remembered_set_slots()->AddSample(
+      static_cast<int>(std::min<size_t>(heap_->remembered_set_slots_visited(),
+                                        kMaxInt)));
+  isolate_->counters()->gc_scavenger_remembered_set_slots_filtered()->AddSample(
+      static_cast<int>(std::min<size_t>(
+          heap_->remembered_set_slots_filtered(), kMaxInt)));
+
   {
     // Update references into new space
     TRACE_GC(heap_->tracer(), GCTracer::Scope::SCAVENGER_SCAVENGE_UPDATE_REFS);
@@ -519,6 +527,7 @@ Scavenger::Scavenger(ScavengerCollector* collector, Heap* heap, bool is_logging,
       local_pretenuring_feedback_(kInitialLocalPretenuringFeedbackCapacity),
       copied_size_(0),
       promoted_size_(0),
+      remembered_set_slots_(0),
       allocator_(heap, LocalSpaceKind::kCompactionSpaceForScavenge),
       is_logging_(is_logging),
       is_incremental_marking_(heap->incremental_marking()->IsMarking()),
@@ -568,6 +577,7 @@ void Scavenger::ScavengePage(MemoryChunk* page) {
     RememberedSet<OLD_TO_NEW>::IterateAndTrackEmptyBuckets(
         page,
         [this, &filter](MaybeObjectSlot slot) {
+          remembered_set_slots_++;
           if (!filter.IsValid(slot.address())) return REMOVE_SLOT;
           return CheckAndScavengeObject(heap_, slot);
         },
@@ -579,6 +589,7 @@ void Scavenger::ScavengePage(MemoryChunk* page) {
     RememberedSetSweeping::Iterate(
         page,
         [this, &filter](MaybeObjectSlot slot) {
+          remembered_set_slots_++;
           if (!filter.IsValid(slot.address())) return REMOVE_SLOT;
           return CheckAndScavengeObject(heap_, slot);
         },
@@ -702,6 +713,7 @@ void Scavenger::Finalize() {
   heap()->MergeAllocationSitePretenuringFeedback(local_pretenuring_feedback_);
   heap()->IncrementSemiSpaceCopiedObjectSize(copied_size_);
   heap()->IncrementPromotedObjectsSize(promoted_size_);
+  heap()->IncrementRememberedSetSlotsVisited(remembered_set_slots_);
   collector_->MergeSurvivingNewLargeObjects(surviving_new_large_objects_);
   allocator_.Finalize();
   empty_chunks_.FlushToGlobal();
@@ -118,6 +118,7 @@ class Scavenger {
 
   size_t bytes_copied() const { return copied_size_; }
   size_t bytes_promoted() const { return promoted_size_; }
+  size_t remembered_set_slots() const { return remembered_set_slots_; }
 
  private:
   // Number of objects to process before interrupting for potentially waking
@@ -196,6 +197,7 @@ class Scavenger {
   Heap::PretenuringFeedbackMap local_pretenuring_feedback_;
   size_t copied_size_;
   size_t promoted_size_;
+  size_t remembered_set_slots_;
   EvacuationAllocator allocator_;
   SurvivingNewLargeObjectsMap surviving_new_large_objects_;
 
@@ -223,6 +223,26 @@ class SlotSet {
     }
   }
 
+  // Like Insert<AccessMode::ATOMIC>() but always sets the bit with a
+  // read-modify-write, even if it is already set. This publishes the store to
+  // the slot that precedes the insertion to a concurrent FilterConcurrently()
+  // that clears the same bit.
+  void InsertAndPublish(size_t slot_offset) {
+    size_t bucket_index;
+    int cell_index, bit_index;
+    SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
+    Bucket* bucket = LoadBucket(bucket_index);
+    if (bucket == nullptr) {
+      bucket = new Bucket;
+      if (!SwapInNewBucket(bucket_index, bucket)) {
+        delete bucket;
+        bucket = LoadBucket(bucket_index);
+      }
+    }
+    DCHECK(bucket != nullptr);
+    bucket->PublishCellBits(cell_index, 1u << bit_index);
+  }
+
   // The slot offset specifies a slot at address page_start_ + slot_offset.
   // Returns true if the set contains the slot.
   bool Contains(size_t slot_offset) {
@@ -249,6 +269,41 @@ class SlotSet {
     }
   }
 
+  // Removes the slots for which |callback| returns REMOVE_SLOT while other
+  // threads may insert slots with InsertAndPublish() or, from generated code,
+  // with an atomic or of the cell. The callback is invoked
+  // again after a bit was cleared, and the slot is re-inserted if the callback
+  // now keeps it. A slot that was written and published concurrently is thus
+  // never lost. Empty buckets are kept. Returns the number of removed slots.
+  template <typename Callback>
+  size_t FilterConcurrently(Address chunk_start, size_t buckets,
+                            Callback callback) {
+    size_t removed = 0;
+    for (size_t bucket_index = 0; bucket_index < buckets; bucket_index++) {
+      Bucket* bucket = LoadBucket(bucket_index);
+      if (bucket == nullptr) continue;
+      size_t cell_offset = bucket_index << kBitsPerBucketLog2;
+      for (int i = 0; i < kCellsPerBucket; i++, cell_offset += kBitsPerCell) {
+        uint32_t cell = bucket->LoadCell(i);
+        while (cell) {
+          int bit_offset = base::bits::CountTrailingZeros(cell);
+          uint32_t bit_mask = 1u << bit_offset;
+          cell ^= bit_mask;
+          MaybeObjectSlot slot(chunk_start +
+                               ((cell_offset + bit_offset) << kTaggedSizeLog2));
+          if (callback(slot) == KEEP_SLOT) continue;
+          bucket->PublishCellBits(i, 0, bit_mask);
+          if (callback(slot) == KEEP_SLOT) {
+            bucket->SetCellBits(i, bit_mask);
+          } else {
+            removed++;
+          }
+        }
+      }
+    }
+    return removed;
+  }
+
   // The slot offsets specify a range of slots at addresses:
   // [page_start_ + start_offset ... page_start_ + end_offset).
   void RemoveRange(size_t start_offset, size_t end_offset, size_t buckets,
@@ -452,6 +507,24 @@ class SlotSet {
       base::AsAtomic32::SetBits(cell(cell_index), 0u, mask);
     }
 
+    // Sets the bits selected by the mask to the given value with an
+    // acquire-release compare-and-swap, even if they already have that value.
+    void PublishCellBits(int cell_index, uint32_t bits, uint32_t mask) {
+      DCHECK_EQ(bits & ~mask, 0u);
+      uint32_t* c = cell(cell_index);
+      uint32_t old_value = base::AsAtomic32::Relaxed_Load(c);
+      uint32_t old_value_before_cas;
+      do {
+        old_value_before_cas = old_value;
+        old_value = base::AsAtomic32::AcquireRelease_CompareAndSwap(
+            c, old_value, (old_value & ~mask) | bits);
+      } while (old_value != old_value_before_cas);
+    }
+
+    void PublishCellBits(int cell_index, uint32_t mask) {
+      PublishCellBits(cell_index, mask, mask);
+    }
+
     void StoreCell(int cell_index, uint32_t value) {
       base::AsAtomic32::Release_Store(cell(cell_index), value);
     }
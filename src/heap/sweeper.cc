@@ -111,8 +111,11 @@ class Sweeper::SweeperJob final : public JobTask {
       const AllocationSpace space_id = static_cast<AllocationSpace>(
           FIRST_GROWABLE_PAGED_SPACE +
           ((i + offset) % kNumberOfSweepingSpaces));
-      // Do not sweep code space concurrently.
-      if (space_id == CODE_SPACE) continue;
+      // Code space is only swept concurrently if code pages stay writable.
+      if (space_id == CODE_SPACE &&
+          !sweeper_->ShouldSweepCodeSpaceConcurrently()) {
+        continue;
+      }
       DCHECK(IsValidSweepingSpace(space_id));
       if (!sweeper_->ConcurrentSweepSpace(space_id, delegate)) return;
     }
@@ -341,8 +344,10 @@ int Sweeper::RawSweep(
   // live bytes and keep track of wasted_memory_.
   p->ResetAllocationStatistics();
 
+  // Code objects are collected separately and published at the end, so that
+  // concurrent lookups in the registry never observe a partially swept page.
   CodeObjectRegistry* code_object_registry = p->GetCodeObjectRegistry();
-  if (code_object_registry) code_object_registry->Clear();
+  std::vector<Address> code_objects;
 
   // Phase 2: Free the non-live memory and clean-up the regular remembered set
   // entires.
@@ -379,8 +384,7 @@ int Sweeper::RawSweep(
   for (auto object_and_size :
        LiveObjectRange<kBlackObjects>(p, marking_state_->bitmap(p))) {
     HeapObject const object = object_and_size.first;
-    if (code_object_registry)
-      code_object_registry->RegisterAlreadyExistingCodeObject(object.address());
+    if (code_object_registry) code_objects.push_back(object.address());
     DCHECK(marking_state_->IsBlack(object));
     Address free_end = object.address();
     if (free_end != free_start) {
@@ -421,7 +425,9 @@ int Sweeper::RawSweep(
   ClearMarkBitsAndHandleLivenessStatistics(p, live_bytes, free_list_mode);
 
   p->set_concurrent_sweeping_state(Page::ConcurrentSweepingState::kDone);
-  if (code_object_registry) code_object_registry->Finalize();
+  if (code_object_registry) {
+    code_object_registry->ReinitializeFrom(std::move(code_objects));
+  }
   if (free_list_mode == IGNORE_FREE_LIST) return 0;
 
   return static_cast<int>(
@@ -430,8 +436,20 @@ int Sweeper::RawSweep(
 
 size_t Sweeper::ConcurrentSweepingPageCount() {
   base::MutexGuard guard(&mutex_);
-  return sweeping_list_[GetSweepSpaceIndex(OLD_SPACE)].size() +
-         sweeping_list_[GetSweepSpaceIndex(MAP_SPACE)].size();
+  size_t count = sweeping_list_[GetSweepSpaceIndex(OLD_SPACE)].size() +
+                 sweeping_list_[GetSweepSpaceIndex(MAP_SPACE)].size();
+  if (ShouldSweepCodeSpaceConcurrently()) {
+    count += sweeping_list_[GetSweepSpaceIndex(CODE_SPACE)].size();
+  }
+  return count;
+}
+
+bool Sweeper::ShouldSweepCodeSpaceConcurrently() const {
+  // Sweeping writes free space fillers into the page. Write protected code
+  // pages would have to be made writable while the mutator executes code on
+  // them.
+  return FLAG_concurrent_sweeping && FLAG_concurrent_code_space_sweeping &&
+         !heap_->write_protect_code_memory();
 }
 
 bool Sweeper::ConcurrentSweepSpace(AllocationSpace identity,
@@ -439,10 +457,12 @@ bool Sweeper::ConcurrentSweepSpace(AllocationSpace identity,
   while (!delegate->ShouldYield()) {
     Page* page = GetSweepingPageSafe(identity);
     if (page == nullptr) return true;
-    // Typed slot sets are only recorded on code pages. Code pages
-    // are not swept concurrently to the application to ensure W^X.
-    DCHECK(!page->typed_slot_set<OLD_TO_NEW>() &&
-           !page->typed_slot_set<OLD_TO_OLD>());
+    // Typed slot sets are only recorded on code pages. Code pages are only
+    // swept concurrently to the application if they are not write protected,
+    // and the write barrier then synchronizes on the page mutex.
+    DCHECK_IMPLIES(identity != CODE_SPACE,
+                   !page->typed_slot_set<OLD_TO_NEW>() &&
+                       !page->typed_slot_set<OLD_TO_OLD>());
     ParallelSweepPage(page, identity);
   }
   return false;
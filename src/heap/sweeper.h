@@ -112,6 +112,9 @@ class Sweeper {
   void DrainSweepingWorklistForSpace(AllocationSpace space);
   bool AreSweeperTasksRunning();
 
+  // Returns true if background sweeper tasks may also sweep code space.
+  bool ShouldSweepCodeSpaceConcurrently() const;
+
   // Support concurrent sweepers from main thread
   void SupportConcurrentSweeping();
 
@@ -28,11 +28,16 @@ namespace internal {
   HR(gc_finalize_sweep, V8.GCFinalizeMC.Sweep, 0, 10000, 101)                  \
   HR(gc_scavenger_scavenge_main, V8.GCScavenger.ScavengeMain, 0, 10000, 101)   \
   HR(gc_scavenger_scavenge_roots, V8.GCScavenger.ScavengeRoots, 0, 10000, 101) \
+  HR(gc_scavenger_remembered_set_slots, V8.GCScavenger.RememberedSetSlots, 0,  \
+     10000000, 50)                                                             \
+  HR(gc_scavenger_remembered_set_slots_filtered,                               \
+     V8.GCScavenger.RememberedSetSlotsFiltered, 0, 10000000, 50)               \
   HR(gc_mark_compactor, V8.GCMarkCompactor, 0, 10000, 101)                     \
   HR(gc_marking_sum, V8.GCMarkingSum, 0, 10000, 101)                           \
   /* Range and bucket matches BlinkGC.MainThreadMarkingThroughput. */          \
   HR(gc_main_thread_marking_throughput, V8.GCMainThreadMarkingThroughput, 0,   \
      100000, 50)                                                               \
+  HR(gc_marking_throughput, V8.GCMarkingThroughput, 0, 100000, 50)             \
   HR(scavenge_reason, V8.GCScavengeReason, 0, 25, 26)                          \
   HR(young_generation_handling, V8.GCYoungGenerationHandling, 0, 2, 3)         \
   /* Asm/Wasm. */                                                              \
@@ -135,6 +140,7 @@ namespace internal {
      V8.GCFinalizeMCReduceMemoryBackground, 10000, MILLISECOND)                \
   HT(gc_finalize_reduce_memory_foreground,                                     \
      V8.GCFinalizeMCReduceMemoryForeground, 10000, MILLISECOND)                \
+  HT(gc_minor_mark_compactor, V8.GCMinorMarkCompactor, 10000, MILLISECOND)     \
   HT(gc_scavenger, V8.GCScavenger, 10000, MILLISECOND)                         \
   HT(gc_scavenger_background, V8.GCScavengerBackground, 10000, MILLISECOND)    \
   HT(gc_scavenger_foreground, V8.GCScavengerForeground, 10000, MILLISECOND)    \
@@ -223,7 +229,10 @@ namespace internal {
   HP(external_fragmentation_code_space,                                        \
      V8.MemoryExternalFragmentationCodeSpace)                                  \
   HP(external_fragmentation_map_space, V8.MemoryExternalFragmentationMapSpace) \
-  HP(external_fragmentation_lo_space, V8.MemoryExternalFragmentationLoSpace)
+  HP(external_fragmentation_lo_space, V8.MemoryExternalFragmentationLoSpace)   \
+  /* Huge page coverage. */                                                    \
+  HP(huge_page_coverage_old_space, V8.MemoryHugePageCoverageOldSpace)          \
+  HP(huge_page_coverage_code_space, V8.MemoryHugePageCoverageCodeSpace)
 
 // Note: These use Histogram with options (min=1000, max=500000, buckets=50).
 #define HISTOGRAM_LEGACY_MEMORY_LIST(HM)                                      \
@@ -314,12 +323,15 @@ namespace internal {
   /* Total count of functions compiled using the baseline compiler. */         \
   SC(total_baseline_compile_count, V8.TotalBaselineCompileCount)
 
-#define STATS_COUNTER_TS_LIST(SC)                                    \
-  SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)            \
-  SC(wasm_reloc_size, V8.WasmRelocBytes)                             \
-  SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions) \
-  SC(liftoff_compiled_functions, V8.LiftoffCompiledFunctions)        \
-  SC(liftoff_unsupported_functions, V8.LiftoffUnsupportedFunctions)
+#define STATS_COUNTER_TS_LIST(SC)                                          \
+  SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)                  \
+  SC(wasm_reloc_size, V8.WasmRelocBytes)                                   \
+  SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions)       \
+  SC(liftoff_compiled_functions, V8.LiftoffCompiledFunctions)              \
+  SC(liftoff_unsupported_functions, V8.LiftoffUnsupportedFunctions)        \
+  /* Bounds checks removed by TurboFan's bounds check elimination. */      \
+  SC(turbofan_bounds_checks_eliminated, V8.TurboFanBoundsChecksEliminated) \
+  SC(turbofan_bounds_checks_merged, V8.TurboFanBoundsChecksMerged)
 
 // List of counters that can be incremented from generated code. We need them in
 // a separate list to be able to relocate them.
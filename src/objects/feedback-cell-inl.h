@@ -57,6 +57,10 @@ void FeedbackCell::SetInterruptBudget() {
   set_interrupt_budget(FLAG_interrupt_budget);
 }
 
+void FeedbackCell::SetInterruptBudgetForMidtier() {
+  set_interrupt_budget(FLAG_interrupt_budget_for_midtier);
+}
+
 void FeedbackCell::IncrementClosureCount(Isolate* isolate) {
   ReadOnlyRoots r(isolate);
   if (map() == r.no_closures_cell_map()) {
@@ -35,6 +35,8 @@ class FeedbackCell : public TorqueGeneratedFeedbackCell<FeedbackCell, Struct> {
           gc_notify_updated_slot = base::nullopt);
   inline void SetInitialInterruptBudget();
   inline void SetInterruptBudget();
+  // Mid-tier code uses its own budget to decide when to tier up further.
+  inline void SetInterruptBudgetForMidtier();
 
   // The closure count is encoded in the cell's map, which distinguishes
   // between zero, one, or many closures. This function records a new closure
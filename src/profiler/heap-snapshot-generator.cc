@@ -8,6 +8,7 @@
 
 #include "src/api/api-inl.h"
 #include "src/base/optional.h"
+#include "src/base/platform/elapsed-timer.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/common/globals.h"
 #include "src/debug/debug.h"
@@ -690,7 +691,11 @@ const char* V8HeapExplorer::GetSystemEntryName(HeapObject object) {
 }
 
 int V8HeapExplorer::EstimateObjectsCount() {
-  CombinedHeapObjectIterator it(heap_, HeapObjectIterator::kFilterUnreachable);
+  // The count is only used for progress reporting. Iterating without
+  // filtering avoids an additional marking pass over the whole heap and
+  // over-approximates the number of objects visited later, so intermediate
+  // progress reports never reach the total.
+  CombinedHeapObjectIterator it(heap_);
   int objects_count = 0;
   while (!it.Next().is_null()) ++objects_count;
   return objects_count;
@@ -2099,10 +2104,16 @@ class V8_NODISCARD NullContextForSnapshotScope {
 
 bool HeapSnapshotGenerator::GenerateSnapshot() {
   Isolate* isolate = Isolate::FromHeap(heap_);
+  base::ElapsedTimer timer;
+  if (FLAG_profile_heap_snapshot) timer.Start();
   base::Optional<HandleScope> handle_scope(base::in_place, isolate);
   v8_heap_explorer_.CollectGlobalObjectsTags();
 
   heap_->CollectAllAvailableGarbage(GarbageCollectionReason::kHeapProfiler);
+  if (FLAG_profile_heap_snapshot) {
+    isolate->PrintWithTimestamp("[Heap snapshot] GC took %0.3f ms\n",
+                                timer.Restart().InMillisecondsF());
+  }
 
   NullContextForSnapshotScope null_context_scope(isolate);
   SafepointScope scope(heap_);
@@ -2126,11 +2137,39 @@ bool HeapSnapshotGenerator::GenerateSnapshot() {
 
   snapshot_->AddSyntheticRootEntries();
 
+  if (FLAG_profile_heap_snapshot) {
+    isolate->PrintWithTimestamp("[Heap snapshot] Preparation took %0.3f ms\n",
+                                timer.Restart().InMillisecondsF());
+  }
+
   if (!FillReferences()) return false;
 
+  if (FLAG_profile_heap_snapshot) {
+    const double duration_ms = timer.Restart().InMillisecondsF();
+    const size_t size_of_objects = heap_->SizeOfObjects();
+    isolate->PrintWithTimestamp(
+        "[Heap snapshot] Extracting references from %zu KB took %0.3f ms "
+        "(%0.1f ms/GB)\n",
+        size_of_objects / KB, duration_ms,
+        size_of_objects > 0
+            ? duration_ms * GB / static_cast<double>(size_of_objects)
+            : 0.0);
+  }
+
+  // The mapping from heap objects to entries is only needed while references
+  // are extracted. Release it before the children vector is allocated to
+  // lower the peak memory usage of snapshot generation.
+  HeapEntriesMap().swap(entries_map_);
+
   snapshot_->FillChildren();
   snapshot_->RememberLastJSObjectId();
 
+  if (FLAG_profile_heap_snapshot) {
+    isolate->PrintWithTimestamp(
+        "[Heap snapshot] Filling children of %zu entries took %0.3f ms\n",
+        snapshot_->entries().size(), timer.Elapsed().InMillisecondsF());
+  }
+
   progress_counter_ = progress_total_;
   if (!ProgressReport(true)) return false;
   return true;
@@ -339,6 +339,7 @@ RUNTIME_FUNCTION(Runtime_BytecodeBudgetInterruptFromBytecode) {
     // OSR. When we OSR functions with lazy feedback allocation we want to have
     // a non zero invocation count so we can inline functions.
     function->feedback_vector().set_invocation_count(1);
+    isolate->runtime_profiler()->NotifyFeedbackVectorAllocated(*function);
     return ReadOnlyRoots(isolate).undefined_value();
   }
   {
@@ -356,7 +357,8 @@ RUNTIME_FUNCTION(Runtime_BytecodeBudgetInterruptFromCode) {
 
   DCHECK(feedback_cell->value().IsFeedbackVector());
 
-  feedback_cell->set_interrupt_budget(FLAG_interrupt_budget);
+  // Only mid-tier code checks its interrupt budget.
+  feedback_cell->SetInterruptBudgetForMidtier();
 
   SealHandleScope shs(isolate);
   isolate->counters()->runtime_profiler_ticks()->Increment();
@@ -2,8 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "include/cppgc/allocation.h"
 #include "include/cppgc/garbage-collected.h"
+#include "include/cppgc/mutator-thread-scope.h"
+#include "src/base/platform/platform.h"
 #include "src/heap/cppgc/globals.h"
 #include "src/heap/cppgc/heap.h"
 #include "test/benchmarks/cpp/cppgc/utils.h"
@@ -44,6 +50,61 @@ BENCHMARK_F(Allocate, Large)(benchmark::State& st) {
   st.SetBytesProcessed(st.iterations() * sizeof(LargeObject));
 }
 
+class AllocateOnAttachedThreads : public testing::BenchmarkWithHeap {
+ protected:
+  cppgc::Heap::HeapOptions GetHeapOptions() const override {
+    cppgc::Heap::HeapOptions options;
+    options.marking_support = cppgc::Heap::MarkingType::kAtomic;
+    options.supports_attached_threads = true;
+    return options;
+  }
+};
+
+class Runner final : public v8::base::Thread {
+ public:
+  explicit Runner(std::function<void()> callback)
+      : Thread(v8::base::Thread::Options("cppgc attached thread")),
+        callback_(std::move(callback)) {}
+
+  void Run() final { callback_(); }
+
+ private:
+  std::function<void()> callback_;
+};
+
+BENCHMARK_DEFINE_F(AllocateOnAttachedThreads, Tiny)(benchmark::State& st) {
+  static constexpr size_t kObjectsPerThread = 100000;
+  const size_t num_threads = static_cast<size_t>(st.range(0));
+  for (auto _ : st) {
+    std::vector<std::unique_ptr<Runner>> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads.push_back(std::make_unique<Runner>([this]() {
+        cppgc::subtle::MutatorThreadScope scope(&heap());
+        for (size_t j = 0; j < kObjectsPerThread; ++j) {
+          benchmark::DoNotOptimize(cppgc::MakeGarbageCollected<TinyObject>(
+              scope.GetAllocationHandle()));
+        }
+      }));
+      threads.back()->Start();
+    }
+    for (auto& thread : threads) thread->Join();
+    st.PauseTiming();
+    heap().ForceGarbageCollectionSlow("AllocateOnAttachedThreads", "Benchmark",
+                                      cppgc::Heap::StackState::kNoHeapPointers);
+    st.ResumeTiming();
+  }
+  st.SetItemsProcessed(st.iterations() * num_threads * kObjectsPerThread);
+  st.SetBytesProcessed(st.iterations() * num_threads * kObjectsPerThread *
+                       sizeof(TinyObject));
+}
+
+BENCHMARK_REGISTER_F(AllocateOnAttachedThreads, Tiny)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
 }  // namespace
 }  // namespace internal
 }  // namespace cppgc
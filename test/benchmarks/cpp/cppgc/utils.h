@@ -19,7 +19,7 @@ class BenchmarkWithHeap : public benchmark::Fixture {
   void SetUp(const ::benchmark::State& state) override {
     platform_ = std::make_shared<testing::TestPlatform>();
     cppgc::InitializeProcess(platform_->GetPageAllocator());
-    heap_ = cppgc::Heap::Create(platform_);
+    heap_ = cppgc::Heap::Create(platform_, GetHeapOptions());
   }
 
   void TearDown(const ::benchmark::State& state) override {
@@ -27,6 +27,10 @@ class BenchmarkWithHeap : public benchmark::Fixture {
     cppgc::ShutdownProcess();
   }
 
+  virtual cppgc::Heap::HeapOptions GetHeapOptions() const {
+    return cppgc::Heap::HeapOptions::Default();
+  }
+
   cppgc::Heap& heap() const { return *heap_.get(); }
 
  private:
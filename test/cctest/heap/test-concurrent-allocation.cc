@@ -4,6 +4,7 @@
 
 #include <memory>
 
+#include "src/api/api-inl.h"
 #include "src/api/api.h"
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
@@ -21,9 +22,11 @@
 #include "src/heap/heap.h"
 #include "src/heap/local-heap-inl.h"
 #include "src/heap/parked-scope.h"
+#include "src/heap/remembered-set.h"
 #include "src/heap/safepoint.h"
 #include "src/objects/heap-number.h"
 #include "src/objects/heap-object.h"
+#include "src/objects/js-array-inl.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/heap-utils.h"
 
@@ -132,6 +135,226 @@ UNINITIALIZED_TEST(ConcurrentAllocationInOldSpaceFromMainThread) {
   isolate->Dispose();
 }
 
+class ConcurrentNewSpaceAllocationThread final : public v8::base::Thread {
+ public:
+  explicit ConcurrentNewSpaceAllocationThread(Heap* heap,
+                                              std::atomic<int>* pending,
+                                              std::atomic<int>* young_objects)
+      : v8::base::Thread(base::Thread::Options("ThreadWithLocalHeap")),
+        heap_(heap),
+        pending_(pending),
+        young_objects_(young_objects) {}
+
+  void Run() override {
+    LocalHeap local_heap(heap_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(&local_heap);
+    for (int i = 0; i < kNumIterations; i++) {
+      Address address = local_heap.AllocateRawOrFail(
+          kSmallObjectSize, AllocationType::kYoung, AllocationOrigin::kRuntime,
+          AllocationAlignment::kWordAligned);
+      CreateFixedArray(heap_, address, kSmallObjectSize);
+      if (Heap::InYoungGeneration(HeapObject::FromAddress(address))) {
+        young_objects_->fetch_add(1);
+      }
+      if (i % 10 == 0) {
+        local_heap.Safepoint();
+      }
+    }
+    pending_->fetch_sub(1);
+  }
+
+  Heap* heap_;
+  std::atomic<int>* pending_;
+  std::atomic<int>* young_objects_;
+};
+
+UNINITIALIZED_TEST(ConcurrentAllocationInNewSpace) {
+  FLAG_concurrent_allocation = true;
+  FLAG_concurrent_new_space_allocation = true;
+  FLAG_local_heaps = true;
+  FLAG_stress_concurrent_allocation = false;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+
+  std::vector<std::unique_ptr<ConcurrentNewSpaceAllocationThread>> threads;
+
+  const int kThreads = 4;
+
+  std::atomic<int> pending(kThreads);
+  std::atomic<int> young_objects(0);
+
+  for (int i = 0; i < kThreads; i++) {
+    auto thread = std::make_unique<ConcurrentNewSpaceAllocationThread>(
+        i_isolate->heap(), &pending, &young_objects);
+    CHECK(thread->Start());
+    threads.push_back(std::move(thread));
+  }
+
+  // Scavenges need to give up the LABs of the background threads.
+  while (pending > 0) {
+    CcTest::CollectGarbage(NEW_SPACE, i_isolate);
+    v8::platform::PumpMessageLoop(i::V8::GetCurrentPlatform(), isolate);
+  }
+
+  for (auto& thread : threads) {
+    thread->Join();
+  }
+
+  CHECK_GT(young_objects, 0);
+  CcTest::CollectGarbage(NEW_SPACE, i_isolate);
+
+  isolate->Dispose();
+}
+
+UNINITIALIZED_TEST(ConcurrentNewSpaceAllocationDuringMarking) {
+  if (!FLAG_incremental_marking) return;
+  FLAG_concurrent_allocation = true;
+  FLAG_concurrent_new_space_allocation = true;
+  FLAG_local_heaps = true;
+  FLAG_stress_concurrent_allocation = false;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    Heap* heap = i_isolate->heap();
+    heap::SimulateIncrementalMarking(heap, false);
+    CHECK(heap->incremental_marking()->IsMarking());
+
+    std::atomic<int> pending(1);
+    std::atomic<int> young_objects(0);
+    auto thread = std::make_unique<ConcurrentNewSpaceAllocationThread>(
+        heap, &pending, &young_objects);
+    CHECK(thread->Start());
+    {
+      ParkedScope parked(i_isolate->main_thread_local_heap());
+      thread->Join();
+    }
+
+    // Background threads get no new space LABs while marking, so their
+    // young objects are allocated black in old space instead.
+    CHECK_EQ(young_objects, 0);
+    CHECK(heap->incremental_marking()->IsMarking());
+  }
+
+  isolate->Dispose();
+}
+
+class ConcurrentOldToNewSlotThread final : public v8::base::Thread {
+ public:
+  explicit ConcurrentOldToNewSlotThread(Heap* heap, FixedArray fixed_array,
+                                        int start, int stride,
+                                        std::atomic<int>* pending)
+      : v8::base::Thread(base::Thread::Options("ThreadWithLocalHeap")),
+        heap_(heap),
+        fixed_array_(fixed_array),
+        start_(start),
+        stride_(stride),
+        pending_(pending) {}
+
+  void Run() override {
+    LocalHeap local_heap(heap_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(&local_heap);
+    for (int i = 0; i < kNumIterations; i++) {
+      Address address = local_heap.AllocateRawOrFail(
+          kSmallObjectSize, AllocationType::kYoung, AllocationOrigin::kRuntime,
+          AllocationAlignment::kWordAligned);
+      CreateFixedArray(heap_, address, kSmallObjectSize);
+      int index = start_ + (i * stride_) % fixed_array_.length();
+      fixed_array_.set(index, HeapObject::FromAddress(address));
+      if (i % 10 == 0) {
+        local_heap.Safepoint();
+      }
+    }
+    pending_->fetch_sub(1);
+  }
+
+  Heap* heap_;
+  FixedArray fixed_array_;
+  int start_;
+  int stride_;
+  std::atomic<int>* pending_;
+};
+
+UNINITIALIZED_TEST(ConcurrentOldToNewSlotsWithGeneratedCode) {
+  FLAG_concurrent_allocation = true;
+  FLAG_concurrent_new_space_allocation = true;
+  FLAG_local_heaps = true;
+  FLAG_stress_concurrent_allocation = false;
+  FLAG_allow_natives_syntax = true;
+  FLAG_allocation_site_pretenuring = false;
+  // The background threads hold the old array without a handle.
+  FLAG_never_compact = true;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    Factory* factory = i_isolate->factory();
+
+    // Background threads record the even slots of the old array with the
+    // runtime write barrier while optimized code records the odd ones with
+    // the RecordWrite builtin. Both modify the same slot set cells.
+    const int kLength = 256;
+    const int kThreads = 4;
+    Handle<FixedArray> elements =
+        factory->NewFixedArray(kLength, AllocationType::kOld);
+    Handle<JSArray> array =
+        factory->NewJSArrayWithElements(elements, PACKED_ELEMENTS, kLength);
+    CHECK(context->Global()
+              ->Set(context, v8_str(isolate, "array"), Utils::ToLocal(array))
+              .FromJust());
+    CompileRunChecked(isolate,
+                      "function store(a) {"
+                      "  for (let i = 1; i < a.length; i += 2) a[i] = {};"
+                      "}"
+                      "%PrepareFunctionForOptimization(store);"
+                      "store(array);"
+                      "%OptimizeFunctionOnNextCall(store);"
+                      "store(array);");
+
+    std::atomic<int> pending(kThreads);
+    std::vector<std::unique_ptr<ConcurrentOldToNewSlotThread>> threads;
+    for (int i = 0; i < kThreads; i++) {
+      auto thread = std::make_unique<ConcurrentOldToNewSlotThread>(
+          i_isolate->heap(), *elements, 2 * i, 2 * kThreads, &pending);
+      CHECK(thread->Start());
+      threads.push_back(std::move(thread));
+    }
+
+    while (pending > 0) {
+      CompileRunChecked(isolate, "store(array);");
+    }
+
+    for (auto& thread : threads) {
+      thread->Join();
+    }
+
+    MemoryChunk* chunk = MemoryChunk::FromHeapObject(*elements);
+    for (int i = 0; i < kLength; i++) {
+      Object value = elements->get(i);
+      if (!Heap::InYoungGeneration(value)) continue;
+      CHECK(RememberedSet<OLD_TO_NEW>::Contains(
+          chunk, elements->RawFieldOfElementAt(i).address()));
+    }
+    CcTest::CollectGarbage(NEW_SPACE, i_isolate);
+  }
+
+  isolate->Dispose();
+}
+
 class LargeObjectConcurrentAllocationThread final : public v8::base::Thread {
  public:
   explicit LargeObjectConcurrentAllocationThread(Heap* heap,
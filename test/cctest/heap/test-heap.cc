@@ -38,6 +38,7 @@
 #include "src/deoptimizer/deoptimizer.h"
 #include "src/execution/execution.h"
 #include "src/handles/global-handles.h"
+#include "src/heap/allocation-lifetime-profiler.h"
 #include "src/heap/combined-heap.h"
 #include "src/heap/factory.h"
 #include "src/heap/gc-tracer.h"
@@ -48,6 +49,7 @@
 #include "src/heap/memory-chunk.h"
 #include "src/heap/memory-reducer.h"
 #include "src/heap/parked-scope.h"
+#include "src/heap/remembered-set-filter.h"
 #include "src/heap/remembered-set-inl.h"
 #include "src/heap/safepoint.h"
 #include "src/ic/ic.h"
@@ -2470,6 +2472,46 @@ TEST(OptimizedAllocationAlwaysInNewSpace) {
 }
 
 
+TEST(SampledPretenuringDecision) {
+  if (FLAG_single_generation) return;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+  AllocationLifetimeProfiler profiler(heap, kTaggedSize);
+
+  Handle<AllocationSite> long_lived = factory->NewAllocationSite(true);
+  Handle<AllocationSite> short_lived = factory->NewAllocationSite(true);
+  std::vector<Handle<FixedArray>> retained;
+  for (int i = 0; i < AllocationLifetimeProfiler::kMinResolvedSamples; i++) {
+    Handle<FixedArray> survivor = factory->NewFixedArray(4);
+    CHECK(Heap::InYoungGeneration(*survivor));
+    profiler.SampleObject(survivor->address(), *long_lived);
+    retained.push_back(survivor);
+    {
+      HandleScope temporary_scope(isolate);
+      Handle<FixedArray> garbage = factory->NewFixedArray(4);
+      profiler.SampleObject(garbage->address(), *short_lived);
+    }
+  }
+  CHECK_EQ(2u, profiler.tracked_sites());
+
+  // Survivors are promoted after at most two scavenges.
+  bool trigger_deoptimization = false;
+  for (int i = 0; i < 2; i++) {
+    CcTest::CollectGarbage(NEW_SPACE);
+    trigger_deoptimization |= profiler.ProcessSamples();
+  }
+  CHECK_EQ(0u, profiler.pending_samples());
+  CHECK(trigger_deoptimization);
+  CHECK_EQ(AllocationSite::kTenure, long_lived->pretenure_decision());
+  CHECK(long_lived->deopt_dependent_code());
+  CHECK_NE(AllocationSite::kTenure, short_lived->pretenure_decision());
+  // Tenured sites are no longer tracked.
+  CHECK_EQ(1u, profiler.tracked_sites());
+}
+
 TEST(OptimizedPretenuringAllocationFolding) {
   FLAG_allow_natives_syntax = true;
   FLAG_expose_gc = true;
@@ -6270,6 +6312,109 @@ TEST(RememberedSet_InsertOnWriteBarrier) {
   CHECK_EQ(3, GetRememberedSetSize<OLD_TO_NEW>(*arr));
 }
 
+TEST(RememberedSet_ConcurrentFiltering) {
+  if (FLAG_single_generation) return;
+  FLAG_stress_concurrent_allocation = false;  // For SealCurrentObjects.
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  heap::SealCurrentObjects(heap);
+  HandleScope scope(isolate);
+  // Make the write barrier publish its inserts and keep the filter of the heap
+  // from racing with the one below.
+  FLAG_concurrent_remembered_set_filtering = true;
+  if (heap->remembered_set_filter()) heap->remembered_set_filter()->Stop();
+
+  Handle<FixedArray> arr = factory->NewFixedArray(3, AllocationType::kOld);
+  {
+    HandleScope scope_inner(isolate);
+    Handle<Object> number = factory->NewHeapNumber(42);
+    arr->set(0, *number);
+    arr->set(1, *number);
+    arr->set(2, *number);
+  }
+  CHECK_EQ(3, GetRememberedSetSize<OLD_TO_NEW>(*arr));
+
+  // Only the last slot still points into the young generation.
+  arr->set(0, Smi::FromInt(1));
+  arr->set(1, *arr);
+
+  RememberedSetFilter filter(heap);
+  filter.Start();
+  filter.RunToCompletionForTesting();
+  CHECK_EQ(2u, filter.slots_removed());
+  CHECK_EQ(1, GetRememberedSetSize<OLD_TO_NEW>(*arr));
+  CHECK(RememberedSet<OLD_TO_NEW>::Contains(
+      MemoryChunk::FromHeapObject(*arr),
+      arr->RawFieldOfElementAt(2).address()));
+
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK_LE(1u, heap->remembered_set_slots_visited());
+}
+
+TEST(RememberedSet_ConcurrentFilteringWithJITStores) {
+  if (FLAG_single_generation) return;
+  FLAG_stress_concurrent_allocation = false;  // For SealCurrentObjects.
+  FLAG_allow_natives_syntax = true;
+  // Keep the stored objects in the young generation.
+  FLAG_allocation_site_pretenuring = false;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  heap::SealCurrentObjects(heap);
+  v8::HandleScope scope(CcTest::isolate());
+  FLAG_concurrent_remembered_set_filtering = true;
+
+  // The elements live in old space, so the stores below record their slots
+  // through the inline remembered set insert of the RecordWrite builtin.
+  const int kLength = 1024;
+  Handle<FixedArray> elements =
+      factory->NewFixedArray(kLength, AllocationType::kOld);
+  Handle<JSArray> array =
+      factory->NewJSArrayWithElements(elements, PACKED_ELEMENTS, kLength);
+  v8::Local<v8::Context> ctx = CcTest::isolate()->GetCurrentContext();
+  CHECK(CcTest::global()
+            ->Set(ctx, v8_str("array"), v8::Utils::ToLocal(array))
+            .FromJust());
+  CompileRun(
+      "function store(a) {"
+      "  for (let i = 0; i < a.length; i++) a[i] = {};"
+      "}"
+      "%PrepareFunctionForOptimization(store);"
+      "store(array);"
+      "%OptimizeFunctionOnNextCall(store);"
+      "store(array);");
+
+  for (int round = 0; round < 16; round++) {
+    if (heap->remembered_set_filter()) heap->remembered_set_filter()->Stop();
+    {
+      HandleScope scope_inner(isolate);
+      Handle<Object> number = factory->NewHeapNumber(42);
+      for (int i = 0; i < kLength; i++) elements->set(i, *number);
+    }
+    // Make all recorded slots stale so that the filter clears their bits
+    // while the optimized code inserts them again.
+    for (int i = 0; i < kLength; i++) elements->set(i, *elements);
+
+    RememberedSetFilter filter(heap);
+    {
+      AlwaysAllocateScopeForTesting always_allocate(heap);
+      filter.Start();
+      CompileRun("store(array);");
+      filter.Stop();
+    }
+    MemoryChunk* chunk = MemoryChunk::FromHeapObject(*elements);
+    for (int i = 0; i < kLength; i++) {
+      CHECK(Heap::InYoungGeneration(elements->get(i)));
+      CHECK(RememberedSet<OLD_TO_NEW>::Contains(
+          chunk, elements->RawFieldOfElementAt(i).address()));
+    }
+    CcTest::CollectGarbage(NEW_SPACE);
+  }
+}
+
 TEST(RememberedSet_InsertInLargePage) {
   if (FLAG_single_generation) return;
   FLAG_stress_concurrent_allocation = false;  // For SealCurrentObjects.
@@ -44,6 +44,7 @@
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/heap-tester.h"
 #include "test/cctest/heap/heap-utils.h"
+#include "test/common/flag-utils.h"
 
 namespace v8 {
 namespace internal {
@@ -229,6 +230,45 @@ TEST(MemoryAllocator) {
   // OldSpace's destructor will tear down the space and free up all pages.
 }
 
+TEST(HugePageCoverage) {
+  FLAG_SCOPE(huge_pages_for_old_space);
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+
+  TestMemoryAllocatorScope test_allocator_scope(isolate, heap->MaxReserved(),
+                                                0);
+  MemoryAllocator* memory_allocator = test_allocator_scope.allocator();
+
+  OldSpace faked_space(heap);
+  CHECK_EQ(0u, MemoryAllocator::HugePageCoveredBytes(&faked_space));
+
+  const size_t kPages =
+      2 * MemoryAllocator::kHugePageSize / MemoryChunk::kPageSize;
+  bool contiguous = true;
+  Page* previous = nullptr;
+  for (size_t i = 0; i < kPages; i++) {
+    Page* page = memory_allocator->AllocatePage(
+        faked_space.AreaSize(), static_cast<PagedSpace*>(&faked_space),
+        NOT_EXECUTABLE);
+    CHECK_NOT_NULL(page);
+    faked_space.memory_chunk_list().PushBack(page);
+    if (previous != nullptr &&
+        page->address() != previous->address() + previous->size()) {
+      contiguous = false;
+    }
+    previous = page;
+  }
+
+  size_t covered = MemoryAllocator::HugePageCoveredBytes(&faked_space);
+  CHECK_LE(covered, kPages * MemoryChunk::kPageSize);
+  CHECK_EQ(0u, covered % MemoryAllocator::kHugePageSize);
+  // Packed pages fill at least one huge page region unless the OS did not
+  // honor the address hints.
+  if (contiguous) CHECK_GE(covered, MemoryAllocator::kHugePageSize);
+
+  // OldSpace's destructor will tear down the space and free up all pages.
+}
+
 TEST(ComputeDiscardMemoryAreas) {
   base::AddressRegion memory_area;
   size_t page_size = MemoryAllocator::GetCommitPageSize();
@@ -967,6 +1007,27 @@ TEST(ReadOnlySpaceMetrics_TwoPages) {
   CHECK_EQ(faked_space->Capacity(), 2 * capacity_per_page);
 }
 
+TEST(ReadOnlySpaceSealMergeable) {
+  FLAG_SCOPE(mergeable_read_only_pages);
+  FlagScope<uint64_t> hash_seed_scope(&FLAG_hash_seed, 42);
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+
+  ReadOnlySpaceScope scope(heap);
+  ReadOnlySpace* faked_space = scope.space();
+
+  HeapObject object =
+      faked_space->AllocateRaw(kTaggedSize, kWordAligned).ToObjectChecked();
+  faked_space->ShrinkPages();
+  faked_space->Seal(ReadOnlySpace::SealMode::kDoNotDetachFromHeap);
+
+  // Sealing still succeeds and leaves the pages readable.
+  CHECK_EQ(faked_space->Size(), kTaggedSize);
+  CHECK_EQ(faked_space->pages().size(), 1u);
+  CHECK_EQ(BasicMemoryChunk::FromHeapObject(object),
+           static_cast<BasicMemoryChunk*>(faked_space->pages().front()));
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
@@ -148,6 +148,43 @@ TEST(Shrinking) {
   CHECK_EQ(32, EphemeronHashTable::cast(weakmap->table()).Capacity());
 }
 
+TEST(ParallelWeakCollectionClearing) {
+  FLAG_parallel_weak_collection_clearing = true;
+  FLAG_incremental_marking = false;
+  LocalContext context;
+  Isolate* isolate = GetIsolateFrom(&context);
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+  Handle<JSWeakMap> weakmap = isolate->factory()->NewJSWeakMap();
+
+  // Use enough entries for the table to be split into several ranges. Every
+  // other key stays alive.
+  const int kEntries = 10000;
+  Handle<FixedArray> live_keys = factory->NewFixedArray(kEntries / 2);
+  {
+    HandleScope scope(isolate);
+    Handle<Map> map = factory->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+    for (int i = 0; i < kEntries; i++) {
+      Handle<JSObject> object = factory->NewJSObjectFromMap(map);
+      Handle<Smi> smi(Smi::FromInt(i), isolate);
+      int32_t object_hash = object->GetOrCreateHash(isolate).value();
+      JSWeakCollection::Set(weakmap, object, smi, object_hash);
+      if (i % 2 == 0) live_keys->set(i / 2, *object);
+    }
+  }
+  CHECK_EQ(kEntries,
+           EphemeronHashTable::cast(weakmap->table()).NumberOfElements());
+
+  CcTest::PreciseCollectAllGarbage();
+  EphemeronHashTable table = EphemeronHashTable::cast(weakmap->table());
+  CHECK_EQ(kEntries / 2, table.NumberOfElements());
+  CHECK_EQ(kEntries / 2, table.NumberOfDeletedElements());
+  for (int i = 0; i < kEntries / 2; i++) {
+    Object key = live_keys->get(i);
+    CHECK_EQ(Smi::FromInt(2 * i), table.Lookup(handle(key, isolate)));
+  }
+}
+
 namespace {
 bool EphemeronHashTableContainsKey(EphemeronHashTable table, HeapObject key) {
   for (InternalIndex i : table.IterateEntries()) {
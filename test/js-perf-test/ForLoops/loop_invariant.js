@@ -0,0 +1,53 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The loop conditions below load the bound from an object on every iteration.
+// The map checks and loads are invariant and can be moved out of the loops.
+
+new BenchmarkSuite('Invariant-ArrayLength', [1000], [
+  new Benchmark('Invariant-ArrayLength', false, false, 0, ArrayLengthLoop),
+]);
+
+new BenchmarkSuite('Invariant-PropertyBound', [1000], [
+  new Benchmark('Invariant-PropertyBound', false, false, 0,
+                PropertyBoundLoop),
+]);
+
+new BenchmarkSuite('Invariant-NestedBound', [1000], [
+  new Benchmark('Invariant-NestedBound', false, false, 0, NestedBoundLoop),
+]);
+
+const values = [];
+for (let i = 0; i < 1000; i++) values.push(i % 7);
+
+const grid = { rows: 20, columns: 50, data: values };
+
+function ArrayLengthLoop() {
+  "use strict";
+  let sum = 0;
+  for (let i = 0; i < values.length; i++) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+function PropertyBoundLoop() {
+  "use strict";
+  let sum = 0;
+  for (let i = 0; i < grid.rows * grid.columns; i++) {
+    sum += grid.data[i];
+  }
+  return sum;
+}
+
+function NestedBoundLoop() {
+  "use strict";
+  let sum = 0;
+  for (let row = 0; row < grid.rows; row++) {
+    for (let column = 0; column < grid.columns; column++) {
+      sum += grid.data[row * grid.columns + column];
+    }
+  }
+  return sum;
+}
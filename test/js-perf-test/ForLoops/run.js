@@ -4,6 +4,7 @@
 
 load('../base.js');
 load('for_loop.js');
+load('loop_invariant.js');
 
 var success = true;
 
@@ -0,0 +1,53 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tight reductions over typed arrays. Each iteration only performs a load and
+// an arithmetic operation, so the loop branch and the induction variable update
+// are a significant part of the work.
+
+new BenchmarkSuite('Float64ArraySum', [1000], [
+  new Benchmark('Float64ArraySum', false, false, 0, Float64ArraySum),
+]);
+
+new BenchmarkSuite('Int32ArraySum', [1000], [
+  new Benchmark('Int32ArraySum', false, false, 0, Int32ArraySum),
+]);
+
+new BenchmarkSuite('Float64ArrayDot', [1000], [
+  new Benchmark('Float64ArrayDot', false, false, 0, Float64ArrayDot),
+]);
+
+const kLength = 4096;
+const float64s = new Float64Array(kLength);
+const other_float64s = new Float64Array(kLength);
+const int32s = new Int32Array(kLength);
+for (let i = 0; i < kLength; i++) {
+  float64s[i] = i * 0.5;
+  other_float64s[i] = kLength - i;
+  int32s[i] = i & 0xff;
+}
+
+function Float64ArraySum() {
+  let sum = 0;
+  for (let i = 0; i < float64s.length; i++) {
+    sum += float64s[i];
+  }
+  return sum;
+}
+
+function Int32ArraySum() {
+  let sum = 0;
+  for (let i = 0; i < int32s.length; i++) {
+    sum = (sum + int32s[i]) | 0;
+  }
+  return sum;
+}
+
+function Float64ArrayDot() {
+  let sum = 0;
+  for (let i = 0; i < float64s.length; i++) {
+    sum += float64s[i] * other_float64s[i];
+  }
+  return sum;
+}
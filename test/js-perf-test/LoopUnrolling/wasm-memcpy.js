@@ -0,0 +1,60 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A byte-wise memcpy in wasm:
+//
+// (module
+//   (memory (export "mem") 1)
+//   (func (export "copy") (param $dst i32) (param $src i32) (param $n i32)
+//     (local $i i32)
+//     (block $done
+//       (br_if $done (i32.eqz (local.get $n)))
+//       (loop $copy
+//         (i32.store8 (i32.add (local.get $dst) (local.get $i))
+//           (i32.load8_u (i32.add (local.get $src) (local.get $i))))
+//         (br_if $copy (i32.lt_u (local.tee $i (i32.add (local.get $i)
+//                                                       (i32.const 1)))
+//                                (local.get $n)))))))
+
+new BenchmarkSuite('WasmMemcpy', [1000], [
+  new Benchmark('WasmMemcpy', false, false, 0, WasmMemcpy, WasmMemcpySetup),
+]);
+
+const kWasmMemcpyBytes = new Uint8Array([
+  0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,  // magic, version
+  0x01, 0x07, 0x01, 0x60, 0x03, 0x7f, 0x7f, 0x7f,  // type section
+  0x00,
+  0x03, 0x02, 0x01, 0x00,                          // function section
+  0x05, 0x03, 0x01, 0x00, 0x01,                    // memory section
+  0x07, 0x0e, 0x02,                                // export section
+  0x03, 0x6d, 0x65, 0x6d, 0x02, 0x00,              //   "mem"
+  0x04, 0x63, 0x6f, 0x70, 0x79, 0x00, 0x00,        //   "copy"
+  0x0a, 0x2d, 0x01, 0x2b, 0x01, 0x01, 0x7f,        // code section, locals
+  0x02, 0x40,                                      // block
+  0x20, 0x02, 0x45, 0x0d, 0x00,                    //   br_if (n == 0)
+  0x03, 0x40,                                      //   loop
+  0x20, 0x00, 0x20, 0x03, 0x6a,                    //     dst + i
+  0x20, 0x01, 0x20, 0x03, 0x6a,                    //     src + i
+  0x2d, 0x00, 0x00,                                //     i32.load8_u
+  0x3a, 0x00, 0x00,                                //     i32.store8
+  0x20, 0x03, 0x41, 0x01, 0x6a, 0x22, 0x03,        //     i = i + 1
+  0x20, 0x02, 0x49, 0x0d, 0x00,                    //     br_if (i < n)
+  0x0b, 0x0b, 0x0b,                                // end, end, end
+]);
+
+const kWasmMemcpySize = 16 * 1024;
+let wasm_copy;
+
+function WasmMemcpySetup() {
+  const instance = new WebAssembly.Instance(
+      new WebAssembly.Module(kWasmMemcpyBytes));
+  const bytes = new Uint8Array(instance.exports.mem.buffer);
+  for (let i = 0; i < kWasmMemcpySize; i++) bytes[i] = i & 0xff;
+  wasm_copy = instance.exports.copy;
+}
+
+function WasmMemcpy() {
+  wasm_copy(kWasmMemcpySize, 0, kWasmMemcpySize);
+  wasm_copy(2 * kWasmMemcpySize, kWasmMemcpySize, kWasmMemcpySize);
+}
@@ -0,0 +1,58 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how quickly freshly created functions reach peak performance. Every
+// run compiles new copies of the workloads from unique source, so no feedback
+// or optimized code is shared between runs, and the time includes interpreting,
+// collecting feedback and tiering up through all available tiers.
+
+new BenchmarkSuite('NumericWarmup', [100], [
+  new Benchmark('NumericWarmup', false, false, 0, NumericWarmup),
+]);
+
+new BenchmarkSuite('PropertyWarmup', [100], [
+  new Benchmark('PropertyWarmup', false, false, 0, PropertyWarmup),
+]);
+
+const kCalls = 2000;
+let generation = 0;
+
+// Returns a new closure with its own SharedFunctionInfo and feedback.
+function Fresh(params, body) {
+  return new Function(params, `// generation ${generation++}\n${body}`);
+}
+
+const kNumericBody = `
+  let sum = 0;
+  for (let i = 0; i < n; i++) {
+    sum += (i * 31 + (sum | 0)) % 17;
+  }
+  return sum;
+`;
+
+function NumericWarmup() {
+  const f = Fresh('n', kNumericBody);
+  let result = 0;
+  for (let i = 0; i < kCalls; i++) result += f(100);
+  return result;
+}
+
+const kPropertyBody = `
+  let sum = 0;
+  for (let i = 0; i < points.length; i++) {
+    const p = points[i];
+    sum += p.x * p.x + p.y * p.y;
+  }
+  return sum;
+`;
+
+const points = [];
+for (let i = 0; i < 100; i++) points.push({x: i, y: 100 - i});
+
+function PropertyWarmup() {
+  const f = Fresh('points', kPropertyBody);
+  let result = 0;
+  for (let i = 0; i < kCalls; i++) result += f(points);
+  return result;
+}
@@ -0,0 +1,73 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Allocation-heavy workloads that stress the young generation collector.
+// The same suites are run with the Scavenger and with --minor-mc so that
+// the V8.GCScavenger and V8.GCMinorMarkCompactor pause distributions can be
+// compared on identical allocation patterns. The scores only reflect
+// throughput; tools/young_gen_pauses.py reports the pause percentiles of
+// both collectors on these suites.
+
+new BenchmarkSuite('ShortLived', [1000], [
+  new Benchmark('ShortLived', false, false, 0, ShortLived),
+]);
+
+new BenchmarkSuite('RequestLived', [1000], [
+  new Benchmark('RequestLived', false, false, 0, RequestLived,
+                RequestLived_Setup, RequestLived_TearDown),
+]);
+
+new BenchmarkSuite('LargeSurvivors', [1000], [
+  new Benchmark('LargeSurvivors', false, false, 0, LargeSurvivors,
+                LargeSurvivors_Setup, LargeSurvivors_TearDown),
+]);
+
+// Objects die almost immediately; survival rate is close to zero.
+function ShortLived() {
+  let sum = 0;
+  for (let i = 0; i < 100000; i++) {
+    const point = {x: i, y: i + 1, tag: 'p'};
+    sum += point.x + point.y;
+  }
+  return sum;
+}
+
+// Objects survive for a bounded window, modelling per-request state that
+// outlives a single scavenge but dies before promotion would pay off.
+const kWindowSize = 4096;
+let window;
+
+function RequestLived_Setup() {
+  window = new Array(kWindowSize);
+}
+
+function RequestLived() {
+  for (let i = 0; i < 50000; i++) {
+    window[i % kWindowSize] = {id: i, payload: [i, i + 1, i + 2], next: null};
+  }
+}
+
+function RequestLived_TearDown() {
+  window = null;
+}
+
+// A large young object graph that is reachable from old space, which makes
+// old-to-new slots dominate marking.
+const kRetainedCount = 20000;
+let retained;
+
+function LargeSurvivors_Setup() {
+  retained = [];
+  for (let i = 0; i < kRetainedCount; i++) retained.push(null);
+}
+
+function LargeSurvivors() {
+  for (let i = 0; i < kRetainedCount; i++) {
+    retained[i] = {value: i, children: [{}, {}]};
+  }
+}
+
+function LargeSurvivors_TearDown() {
+  retained = null;
+}
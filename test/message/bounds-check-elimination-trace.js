@@ -0,0 +1,21 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-bounds-check-elimination
+// Flags: --trace-turbo-bounds-check-elimination --no-turbo-loop-peeling
+// Flags: --no-stress-opt --no-always-opt
+
+// The check of a[i] is guarded by the loop condition, also for typed arrays
+// whose lengths are not Unsigned31 on 64-bit platforms.
+function sum(a) {
+  let result = 0;
+  for (let i = 0; i < a.length; i++) result += a[i];
+  return result;
+}
+
+const array = new Int32Array([1, 2, 3, 4]);
+%PrepareFunctionForOptimization(sum);
+sum(array);
+%OptimizeFunctionOnNextCall(sum);
+print(sum(array));
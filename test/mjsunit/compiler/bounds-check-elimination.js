@@ -0,0 +1,57 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-bounds-check-elimination
+
+// Checks guarded by the loop condition.
+(function() {
+  function sum(a) {
+    let result = 0;
+    for (let i = 0; i < a.length; i++) result += a[i];
+    return result;
+  }
+
+  const array = [1, 2, 3, 4];
+  const typed_array = new Int32Array(array);
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(10, sum(array));
+  assertEquals(10, sum(typed_array));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(10, sum(array));
+  assertEquals(10, sum(typed_array));
+  assertEquals(0, sum([]));
+})();
+
+// Checks of neighbouring elements are merged; the last iteration reads past
+// the end and has to deoptimize.
+(function() {
+  function pairs(a) {
+    let result = 0;
+    for (let i = 0; i < a.length; i++) result += a[i] + a[i + 1];
+    return result;
+  }
+
+  const array = new Float64Array([1, 2, 3, 4]);
+  %PrepareFunctionForOptimization(pairs);
+  assertEquals(NaN, pairs(array));
+  %OptimizeFunctionOnNextCall(pairs);
+  assertEquals(NaN, pairs(array));
+})();
+
+// The length is reloaded after the array shrinks inside of the loop.
+(function() {
+  function shrink(a) {
+    let result = 0;
+    for (let i = 0; i < a.length; i++) {
+      result += a[i];
+      if (i == 1) a.length = 2;
+    }
+    return result;
+  }
+
+  %PrepareFunctionForOptimization(shrink);
+  assertEquals(3, shrink([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(shrink);
+  assertEquals(3, shrink([1, 2, 3, 4]));
+})();
@@ -0,0 +1,283 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/bounds-check-elimination.h"
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/feedback-source.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class BoundsCheckEliminationTest : public TypedGraphTest {
+ public:
+  BoundsCheckEliminationTest()
+      : TypedGraphTest(3),
+        javascript_(zone()),
+        machine_(zone()),
+        simplified_(zone()),
+        jsgraph_(isolate(), graph(), common(), &javascript_, &simplified_,
+                 &machine_) {}
+  ~BoundsCheckEliminationTest() override = default;
+
+ protected:
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  Node* CheckBounds(Node* index, Node* length, Node* effect, Node* control) {
+    return graph()->NewNode(simplified()->CheckBounds(FeedbackSource()),
+                            index, length, effect, control);
+  }
+
+  // Returns the IfTrue or IfFalse projection of a branch on {condition}.
+  Node* Guard(Node* condition, bool polarity) {
+    Node* branch = graph()->NewNode(common()->Branch(), condition, start());
+    return graph()->NewNode(
+        polarity ? common()->IfTrue() : common()->IfFalse(), branch);
+  }
+
+  void Run(Node* value, Node* effect, Node* control) {
+    Node* ret = graph()->NewNode(common()->Return(), Int32Constant(0), value,
+                                 effect, control);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    BoundsCheckElimination elimination(&jsgraph_, zone());
+    elimination.Run();
+    eliminated_checks_ = elimination.eliminated_checks();
+    merged_checks_ = elimination.merged_checks();
+  }
+
+  size_t eliminated_checks() const { return eliminated_checks_; }
+  size_t merged_checks() const { return merged_checks_; }
+
+ private:
+  JSOperatorBuilder javascript_;
+  MachineOperatorBuilder machine_;
+  SimplifiedOperatorBuilder simplified_;
+  JSGraph jsgraph_;
+  size_t eliminated_checks_ = 0;
+  size_t merged_checks_ = 0;
+};
+
+// -----------------------------------------------------------------------------
+// Elimination
+
+TEST_F(BoundsCheckEliminationTest, EliminatesCheckGuardedByLessThan) {
+  Node* index = Parameter(Type::Range(0, 100000, zone()), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* control =
+      Guard(graph()->NewNode(simplified()->NumberLessThan(), index, length),
+            true);
+  Node* check = CheckBounds(index, length, start(), control);
+  Run(check, check, control);
+
+  EXPECT_EQ(1u, eliminated_checks());
+  EXPECT_THAT(check, IsTypeGuard(index, control));
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(check));
+}
+
+TEST_F(BoundsCheckEliminationTest, EliminatesCheckOnFalseBranchOfLessThan) {
+  Node* base = Parameter(Type::Range(1, 100000, zone()), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  // !(length < base) implies base <= length, i.e. base - 1 < length.
+  Node* control =
+      Guard(graph()->NewNode(simplified()->NumberLessThan(), length, base),
+            false);
+  Node* index = graph()->NewNode(simplified()->NumberSubtract(), base,
+                                 NumberConstant(1));
+  Node* check = CheckBounds(index, length, start(), control);
+  Run(check, check, control);
+
+  EXPECT_EQ(1u, eliminated_checks());
+  EXPECT_THAT(check, IsTypeGuard(index, control));
+}
+
+TEST_F(BoundsCheckEliminationTest, KeepsCheckWithoutGuard) {
+  Node* index = Parameter(Type::Range(0, 100000, zone()), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* check = CheckBounds(index, length, start(), start());
+  Run(check, check, start());
+
+  EXPECT_EQ(0u, eliminated_checks());
+  EXPECT_EQ(IrOpcode::kCheckBounds, check->opcode());
+}
+
+TEST_F(BoundsCheckEliminationTest, KeepsCheckOnFalseBranchOfGuard) {
+  Node* index = Parameter(Type::Range(0, 100000, zone()), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* control =
+      Guard(graph()->NewNode(simplified()->NumberLessThan(), index, length),
+            false);
+  Node* check = CheckBounds(index, length, start(), control);
+  Run(check, check, control);
+
+  EXPECT_EQ(0u, eliminated_checks());
+  EXPECT_EQ(IrOpcode::kCheckBounds, check->opcode());
+}
+
+TEST_F(BoundsCheckEliminationTest, KeepsCheckOfPossiblyNegativeIndex) {
+  Node* index = Parameter(Type::Signed32(), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* control =
+      Guard(graph()->NewNode(simplified()->NumberLessThan(), index, length),
+            true);
+  Node* check = CheckBounds(index, length, start(), control);
+  Run(check, check, control);
+
+  EXPECT_EQ(0u, eliminated_checks());
+  EXPECT_EQ(IrOpcode::kCheckBounds, check->opcode());
+}
+
+TEST_F(BoundsCheckEliminationTest, KeepsCheckOfIncrementedIndex) {
+  Node* base = Parameter(Type::Range(0, 100000, zone()), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* control =
+      Guard(graph()->NewNode(simplified()->NumberLessThan(), base, length),
+            true);
+  Node* index =
+      graph()->NewNode(simplified()->NumberAdd(), base, NumberConstant(1));
+  Node* check = CheckBounds(index, length, start(), control);
+  Run(check, check, control);
+
+  EXPECT_EQ(0u, eliminated_checks());
+  EXPECT_EQ(IrOpcode::kCheckBounds, check->opcode());
+}
+
+TEST_F(BoundsCheckEliminationTest, EliminatesCheckAgainstTypedArrayLength) {
+  // Typed arrays can be longer than Unsigned31 on 64-bit platforms.
+  Node* index = Parameter(Type::Range(0, kMaxUInt32, zone()), 0);
+  Node* length = Parameter(Type::Range(0, kMaxUInt32 + 1.0, zone()), 1);
+  Node* control =
+      Guard(graph()->NewNode(simplified()->NumberLessThan(), index, length),
+            true);
+  Node* check = CheckBounds(index, length, start(), control);
+  Run(check, check, control);
+
+  EXPECT_EQ(1u, eliminated_checks());
+  EXPECT_THAT(check, IsTypeGuard(index, control));
+}
+
+// -----------------------------------------------------------------------------
+// Merging
+
+TEST_F(BoundsCheckEliminationTest, MergesChecksOfAdjacentIndices) {
+  Node* base = Parameter(Type::Range(0, 100000, zone()), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* index1 =
+      graph()->NewNode(simplified()->NumberAdd(), base, NumberConstant(1));
+  Node* index2 =
+      graph()->NewNode(simplified()->NumberAdd(), base, NumberConstant(2));
+  Node* check0 = CheckBounds(base, length, start(), start());
+  Node* check2 = CheckBounds(index2, length, check0, start());
+  Node* check1 = CheckBounds(index1, length, check2, start());
+  Run(check1, check1, start());
+
+  EXPECT_EQ(0u, eliminated_checks());
+  EXPECT_EQ(2u, merged_checks());
+  EXPECT_THAT(check0, IsTypeGuard(base, start()));
+  EXPECT_THAT(check1, IsTypeGuard(index1, start()));
+  EXPECT_THAT(check2, IsTypeGuard(index2, start()));
+  Node* widened = NodeProperties::GetEffectInput(check0);
+  ASSERT_EQ(IrOpcode::kCheckBounds, widened->opcode());
+  EXPECT_THAT(widened->InputAt(0), IsNumberAdd(base, IsNumberConstant(2)));
+  EXPECT_EQ(length, widened->InputAt(1));
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(widened));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(widened));
+}
+
+TEST_F(BoundsCheckEliminationTest, MergesChecksWithUnknownLowerBound) {
+  Node* base = Parameter(Type::Range(-1000, 100000, zone()), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* index0 =
+      graph()->NewNode(simplified()->NumberSubtract(), base, NumberConstant(1));
+  Node* index2 =
+      graph()->NewNode(simplified()->NumberAdd(), base, NumberConstant(1));
+  Node* check0 = CheckBounds(index0, length, start(), start());
+  Node* check1 = CheckBounds(base, length, check0, start());
+  Node* check2 = CheckBounds(index2, length, check1, start());
+  Run(check2, check2, start());
+
+  // Both ends of the range of indices are checked.
+  EXPECT_EQ(1u, merged_checks());
+  EXPECT_EQ(IrOpcode::kTypeGuard, check0->opcode());
+  EXPECT_EQ(IrOpcode::kTypeGuard, check1->opcode());
+  EXPECT_EQ(IrOpcode::kTypeGuard, check2->opcode());
+  Node* upper = NodeProperties::GetEffectInput(check0);
+  ASSERT_EQ(IrOpcode::kCheckBounds, upper->opcode());
+  EXPECT_THAT(upper->InputAt(0), IsNumberAdd(base, IsNumberConstant(1)));
+  Node* lower = NodeProperties::GetEffectInput(upper);
+  ASSERT_EQ(IrOpcode::kCheckBounds, lower->opcode());
+  EXPECT_THAT(lower->InputAt(0), IsNumberAdd(base, IsNumberConstant(-1)));
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(lower));
+}
+
+TEST_F(BoundsCheckEliminationTest, DoesNotMergeChecksAcrossStore) {
+  Node* base = Parameter(Type::Range(0, 100000, zone()), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* object = Parameter(Type::Object(), 2);
+  Node* index =
+      graph()->NewNode(simplified()->NumberAdd(), base, NumberConstant(1));
+  Node* check0 = CheckBounds(base, length, start(), start());
+  Node* store = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForJSObjectElements()), object,
+      object, check0, start());
+  Node* check1 = CheckBounds(index, length, store, start());
+  Run(check1, check1, start());
+
+  EXPECT_EQ(0u, merged_checks());
+  EXPECT_EQ(IrOpcode::kCheckBounds, check0->opcode());
+  EXPECT_EQ(IrOpcode::kCheckBounds, check1->opcode());
+}
+
+TEST_F(BoundsCheckEliminationTest, MergesChecksAgainstTypedArrayLength) {
+  Node* base = Parameter(Type::Range(0, kMaxUInt32 + 1.0, zone()), 0);
+  Node* length = Parameter(Type::Range(0, kMaxUInt32 + 1.0, zone()), 1);
+  Node* index1 =
+      graph()->NewNode(simplified()->NumberAdd(), base, NumberConstant(1));
+  Node* index2 =
+      graph()->NewNode(simplified()->NumberAdd(), base, NumberConstant(2));
+  Node* check0 = CheckBounds(base, length, start(), start());
+  Node* check1 = CheckBounds(index1, length, check0, start());
+  Node* check2 = CheckBounds(index2, length, check1, start());
+  Run(check2, check2, start());
+
+  EXPECT_EQ(2u, merged_checks());
+  EXPECT_EQ(IrOpcode::kTypeGuard, check0->opcode());
+  EXPECT_EQ(IrOpcode::kTypeGuard, check1->opcode());
+  EXPECT_EQ(IrOpcode::kTypeGuard, check2->opcode());
+  Node* widened = NodeProperties::GetEffectInput(check0);
+  ASSERT_EQ(IrOpcode::kCheckBounds, widened->opcode());
+  EXPECT_THAT(widened->InputAt(0), IsNumberAdd(base, IsNumberConstant(2)));
+  EXPECT_EQ(length, widened->InputAt(1));
+}
+
+TEST_F(BoundsCheckEliminationTest, DoesNotMergeChecksOfUnsafeIntegers) {
+  Node* base = Parameter(Type::Range(0, kMaxSafeInteger, zone()), 0);
+  Node* length = Parameter(Type::Range(0, kMaxSafeInteger, zone()), 1);
+  Node* index1 =
+      graph()->NewNode(simplified()->NumberAdd(), base, NumberConstant(1));
+  Node* index2 =
+      graph()->NewNode(simplified()->NumberAdd(), base, NumberConstant(2));
+  Node* check0 = CheckBounds(base, length, start(), start());
+  Node* check1 = CheckBounds(index1, length, check0, start());
+  Node* check2 = CheckBounds(index2, length, check1, start());
+  Run(check2, check2, start());
+
+  // The indices {base + 1} and {base + 2} may exceed the safe integer range,
+  // where adding offsets is no longer exact.
+  EXPECT_EQ(0u, merged_checks());
+  EXPECT_EQ(IrOpcode::kCheckBounds, check0->opcode());
+  EXPECT_EQ(IrOpcode::kCheckBounds, check1->opcode());
+  EXPECT_EQ(IrOpcode::kCheckBounds, check2->opcode());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,237 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-invariant-code-motion.h"
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/feedback-source.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopInvariantCodeMotionTest : public GraphTest {
+ public:
+  LoopInvariantCodeMotionTest() : GraphTest(3), simplified_(zone()) {}
+  ~LoopInvariantCodeMotionTest() override = default;
+
+ protected:
+  // A loop that is controlled by {Parameter(1)}, with an EffectPhi whose back
+  // edge is connected by {Close}.
+  struct Loop {
+    Node* loop;
+    Node* effect_phi;
+    Node* if_true;
+    Node* if_false;
+  };
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  Loop NewLoop() {
+    Loop l;
+    l.loop = graph()->NewNode(common()->Loop(2), start(), start());
+    l.effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), l.loop);
+    Node* branch = graph()->NewNode(common()->Branch(), Parameter(1), l.loop);
+    l.if_true = graph()->NewNode(common()->IfTrue(), branch);
+    l.if_false = graph()->NewNode(common()->IfFalse(), branch);
+    return l;
+  }
+
+  void Close(const Loop& l, Node* effect) {
+    l.loop->ReplaceInput(1, l.if_true);
+    l.effect_phi->ReplaceInput(1, effect);
+    Node* zero = graph()->NewNode(common()->Int32Constant(0));
+    Node* ret = graph()->NewNode(common()->Return(), zero, Parameter(0),
+                                 l.effect_phi, l.if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+  }
+
+  Node* FrameStateWithLocal(Node* local) {
+    Node* empty =
+        graph()->NewNode(common()->StateValues(0, SparseInputMask::Dense()));
+    Node* locals = graph()->NewNode(
+        common()->StateValues(1, SparseInputMask::Dense()), local);
+    FrameStateFunctionInfo const* function_info =
+        common()->CreateFrameStateFunctionInfo(
+            FrameStateType::kInterpretedFunction, 0, 1,
+            Handle<SharedFunctionInfo>());
+    return graph()->NewNode(
+        common()->FrameState(BailoutId::None(),
+                             OutputFrameStateCombine::Ignore(), function_info),
+        empty, locals, empty, NumberConstant(0), UndefinedConstant(),
+        start());
+  }
+
+  const Operator* CheckMaps() {
+    return simplified()->CheckMaps(
+        CheckMapsFlag::kNone,
+        ZoneHandleSet<Map>(factory()->heap_number_map()));
+  }
+
+  size_t Optimize() {
+    LoopTree* loop_tree =
+        LoopFinder::BuildLoopTree(graph(), tick_counter(), zone());
+    CHECK_EQ(1u, loop_tree->outer_loops().size());
+    LoopInvariantCodeMotion licm(graph(), common(), loop_tree, zone());
+    return licm.OptimizeLoop(loop_tree->outer_loops()[0]);
+  }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+TEST_F(LoopInvariantCodeMotionTest, HoistsInvariantCheckAndLoad) {
+  Loop l = NewLoop();
+  Node* object = Parameter(0);
+  Node* checkpoint = graph()->NewNode(common()->Checkpoint(),
+                                      EmptyFrameState(), l.effect_phi, l.loop);
+  Node* check = graph()->NewNode(CheckMaps(), object, checkpoint, l.loop);
+  Node* load = graph()->NewNode(
+      simplified()->LoadField(AccessBuilder::ForJSObjectElements()), object,
+      check, l.loop);
+  Close(l, load);
+
+  EXPECT_EQ(2u, Optimize());
+
+  // The checkpoint in front of the loop reuses the frame state, which does
+  // not depend on the loop.
+  Node* entry_checkpoint = NodeProperties::GetEffectInput(check);
+  ASSERT_EQ(IrOpcode::kCheckpoint, entry_checkpoint->opcode());
+  EXPECT_EQ(NodeProperties::GetFrameStateInput(checkpoint),
+            NodeProperties::GetFrameStateInput(entry_checkpoint));
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(entry_checkpoint));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(entry_checkpoint));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(check));
+  EXPECT_EQ(check, NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(load));
+  EXPECT_EQ(load, l.effect_phi->InputAt(0));
+  EXPECT_EQ(checkpoint, l.effect_phi->InputAt(1));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, DoesNotHoistLoadOfStoredField) {
+  Loop l = NewLoop();
+  Node* object = Parameter(0);
+  FieldAccess const access = AccessBuilder::ForJSObjectElements();
+  Node* checkpoint = graph()->NewNode(common()->Checkpoint(),
+                                      EmptyFrameState(), l.effect_phi, l.loop);
+  Node* check = graph()->NewNode(CheckMaps(), object, checkpoint, l.loop);
+  Node* load =
+      graph()->NewNode(simplified()->LoadField(access), object, check, l.loop);
+  Node* store = graph()->NewNode(simplified()->StoreField(access), object,
+                                 Parameter(2), load, l.if_true);
+  Close(l, store);
+
+  // The store does not change the map, so only the check is hoisted.
+  EXPECT_EQ(1u, Optimize());
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(check));
+  EXPECT_EQ(l.loop, NodeProperties::GetControlInput(load));
+  EXPECT_EQ(checkpoint, NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(check, l.effect_phi->InputAt(0));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, HoistsPastStoresToObjectsAllocatedInLoop) {
+  Loop l = NewLoop();
+  FieldAccess const access = AccessBuilder::ForJSObjectElements();
+  Node* load = graph()->NewNode(simplified()->LoadField(access), Parameter(0),
+                                l.effect_phi, l.loop);
+  Node* allocation = graph()->NewNode(
+      simplified()->Allocate(Type::Any(), AllocationType::kYoung),
+      NumberConstant(16), load, l.if_true);
+  Node* store = graph()->NewNode(simplified()->StoreField(access), allocation,
+                                 Parameter(2), allocation, l.if_true);
+  Close(l, store);
+
+  // The store initializes an object that is fresh in every iteration.
+  EXPECT_EQ(1u, Optimize());
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(load));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, DoesNotHoistLoadOfObjectAllocatedBefore) {
+  Loop l = NewLoop();
+  FieldAccess const access = AccessBuilder::ForJSObjectElements();
+  Node* object = graph()->NewNode(
+      simplified()->Allocate(Type::Any(), AllocationType::kYoung),
+      NumberConstant(16), start(), start());
+  l.effect_phi->ReplaceInput(0, object);
+  Node* load = graph()->NewNode(simplified()->LoadField(access), object,
+                                l.effect_phi, l.loop);
+  Node* store = graph()->NewNode(simplified()->StoreField(access), object,
+                                 Parameter(2), load, l.if_true);
+  Close(l, store);
+
+  // The object is the same in every iteration, so the store kills the field.
+  EXPECT_EQ(0u, Optimize());
+  EXPECT_EQ(l.loop, NodeProperties::GetControlInput(load));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, DoesNotHoistChecksOfStoredMap) {
+  Loop l = NewLoop();
+  Node* object = Parameter(0);
+  Node* checkpoint = graph()->NewNode(common()->Checkpoint(),
+                                      EmptyFrameState(), l.effect_phi, l.loop);
+  Node* check = graph()->NewNode(CheckMaps(), object, checkpoint, l.loop);
+  Node* store = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForMap()), object, Parameter(2),
+      check, l.if_true);
+  Close(l, store);
+
+  EXPECT_EQ(0u, Optimize());
+  EXPECT_EQ(l.loop, NodeProperties::GetControlInput(check));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, DoesNotHoistLoopVariantCheck) {
+  Loop l = NewLoop();
+  Node* phi =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                       Parameter(2), Parameter(2), l.loop);
+  Node* checkpoint = graph()->NewNode(common()->Checkpoint(),
+                                      EmptyFrameState(), l.effect_phi, l.loop);
+  Node* check = graph()->NewNode(simplified()->CheckSmi(FeedbackSource()),
+                                 phi, checkpoint, l.loop);
+  phi->ReplaceInput(1, check);
+  Close(l, check);
+
+  EXPECT_EQ(0u, Optimize());
+  EXPECT_EQ(l.loop, NodeProperties::GetControlInput(check));
+  EXPECT_EQ(checkpoint, NodeProperties::GetEffectInput(check));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, HoistedCheckDeoptimizesWithEntryValues) {
+  Loop l = NewLoop();
+  Node* init = Parameter(2);
+  Node* phi = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, 2), init, init, l.loop);
+  Node* frame_state = FrameStateWithLocal(phi);
+  Node* checkpoint = graph()->NewNode(common()->Checkpoint(), frame_state,
+                                      l.effect_phi, l.loop);
+  Node* check = graph()->NewNode(simplified()->CheckSmi(FeedbackSource()),
+                                 Parameter(0), checkpoint, l.loop);
+  Node* add = graph()->NewNode(simplified()->SpeculativeSafeIntegerAdd(
+                                   NumberOperationHint::kSignedSmall),
+                               phi, check, check, l.if_true);
+  phi->ReplaceInput(1, add);
+  Close(l, add);
+
+  EXPECT_EQ(1u, Optimize());
+  Node* entry_checkpoint = NodeProperties::GetEffectInput(check);
+  ASSERT_EQ(IrOpcode::kCheckpoint, entry_checkpoint->opcode());
+  Node* entry_frame_state =
+      NodeProperties::GetFrameStateInput(entry_checkpoint);
+  EXPECT_NE(frame_state, entry_frame_state);
+  EXPECT_EQ(init, entry_frame_state->InputAt(1)->InputAt(0));
+  // The checkpoint inside of the loop keeps referring to the phi.
+  EXPECT_EQ(phi, frame_state->InputAt(1)->InputAt(0));
+  EXPECT_EQ(checkpoint, NodeProperties::GetEffectInput(add));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -15,6 +15,7 @@
 #include "test/unittests/compiler/node-test-utils.h"
 #include "testing/gmock-support.h"
 
+using testing::_;
 using testing::AllOf;
 using testing::BitEq;
 using testing::Capture;
@@ -531,6 +532,120 @@ TEST_F(LoopPeelingTest, SimpleLoopWithUnmarkedExit) {
 }
 
 
+TEST_F(LoopPeelingTest, UnrollSimpleLoopWithCounter) {
+  Node* p0 = Parameter(0);
+  While w = NewWhile(p0);
+  Counter c = NewCounter(&w, 0, 1);
+  Node* r = InsertReturn(c.exit_marker, start(), w.exit);
+
+  LoopTree* loop_tree = GetLoopTree();
+  LoopTree::Loop* loop = loop_tree->outer_loops()[0];
+  LoopPeeler peeler(graph(), common(), loop_tree, zone(), source_positions(),
+                    node_origins());
+  EXPECT_TRUE(peeler.CanUnroll(loop));
+  peeler.Unroll(loop, 3);
+
+  // The backedge of each iteration enters the next one.
+  EXPECT_EQ(start(), w.loop->InputAt(0));
+  Node* branch3 = w.loop->InputAt(1)->InputAt(0);
+  Node* branch2 = branch3->InputAt(1)->InputAt(0);
+  EXPECT_THAT(w.loop->InputAt(1), IsIfTrue(branch3));
+  EXPECT_THAT(branch3, IsBranch(p0, IsIfTrue(branch2)));
+  EXPECT_THAT(branch2, IsBranch(p0, w.if_true));
+
+  Node* add3 = c.phi->InputAt(1);
+  Node* add2 = add3->InputAt(0);
+  EXPECT_THAT(c.phi,
+              IsPhi(MachineRepresentation::kTagged, c.base, add3, w.loop));
+  EXPECT_THAT(add3, IsInt32Add(add2, c.inc));
+  EXPECT_THAT(add2, IsInt32Add(c.add, c.inc));
+
+  // The exits of all iterations are merged in front of the loop exit.
+  Node* merge = w.exit->InputAt(0);
+  EXPECT_EQ(IrOpcode::kLoopExit, w.exit->opcode());
+  EXPECT_EQ(w.loop, w.exit->InputAt(1));
+  EXPECT_THAT(merge,
+              IsMerge(w.if_false, IsIfFalse(branch2), IsIfFalse(branch3)));
+  EXPECT_EQ(IrOpcode::kLoopExitValue, c.exit_marker->opcode());
+  EXPECT_THAT(c.exit_marker->InputAt(0),
+              IsPhi(MachineRepresentation::kTagged, c.phi, c.add, add2, merge));
+  EXPECT_EQ(w.exit, NodeProperties::GetControlInput(c.exit_marker));
+  EXPECT_EQ(c.exit_marker, NodeProperties::GetValueInput(r, 1));
+
+  // The exits are still marked, so the unrolled loop can be peeled.
+  LoopTree* unrolled_loop_tree = GetLoopTree();
+  LoopPeeler unrolled_peeler(graph(), common(), unrolled_loop_tree, zone(),
+                             source_positions(), node_origins());
+  EXPECT_TRUE(unrolled_peeler.CanPeel(unrolled_loop_tree->outer_loops()[0]));
+}
+
+
+TEST_F(LoopPeelingTest, UnrollInnerLoopsOfTree) {
+  Node* p0 = Parameter(0);
+  While outer = NewWhile(p0);
+  While inner = NewWhile(p0);
+  Nest(&inner, &outer);
+
+  Counter c = NewCounter(&inner, 0, 1);
+  InsertReturn(p0, start(), outer.exit);
+
+  LoopTree* loop_tree = GetLoopTree();
+  LoopTree::Loop* outer_loop = loop_tree->outer_loops()[0];
+  LoopTree::Loop* inner_loop = loop_tree->ContainingLoop(inner.loop);
+  LoopPeeler peeler(graph(), common(), loop_tree, zone(), source_positions(),
+                    node_origins());
+  EXPECT_FALSE(peeler.CanUnroll(outer_loop));
+  EXPECT_TRUE(peeler.CanUnroll(inner_loop));
+  EXPECT_EQ(LoopPeeler::kMaxUnrollingCount,
+            LoopPeeler::UnrollingCount(inner_loop));
+
+  peeler.UnrollInnerLoopsOfTree();
+
+  // Only the inner loop is unrolled.
+  EXPECT_THAT(outer.loop, IsLoop(start(), inner.exit));
+  EXPECT_NE(c.add, c.phi->InputAt(1));
+  EXPECT_THAT(c.phi->InputAt(1), IsInt32Add(_, c.inc));
+}
+
+
+TEST_F(LoopPeelingTest, DoNotUnrollLoopWithoutInductionVariable) {
+  Node* p0 = Parameter(0);
+  While w = NewWhile(p0);
+  Node* r = InsertReturn(p0, start(), w.exit);
+
+  LoopTree* loop_tree = GetLoopTree();
+  LoopPeeler peeler(graph(), common(), loop_tree, zone(), source_positions(),
+                    node_origins());
+  EXPECT_TRUE(peeler.CanUnroll(loop_tree->outer_loops()[0]));
+  peeler.UnrollInnerLoopsOfTree();
+
+  EXPECT_THAT(w.loop, IsLoop(start(), w.if_true));
+  EXPECT_EQ(w.if_false, w.exit->InputAt(0));
+  EXPECT_THAT(r, IsReturn(p0, start(), w.exit));
+}
+
+
+TEST_F(LoopPeelingTest, TwoBackedgeLoopCannotBeUnrolled) {
+  Node* p0 = Parameter(0);
+  Node* loop = graph()->NewNode(common()->Loop(3), start(), start(), start());
+  Branch b1 = NewBranch(p0, loop);
+  Branch b2 = NewBranch(p0, b1.if_true);
+
+  loop->ReplaceInput(1, b2.if_true);
+  loop->ReplaceInput(2, b2.if_false);
+
+  Node* exit = graph()->NewNode(common()->LoopExit(), b1.if_false, loop);
+
+  InsertReturn(p0, start(), exit);
+
+  LoopTree* loop_tree = GetLoopTree();
+  LoopPeeler peeler(graph(), common(), loop_tree, zone(), source_positions(),
+                    node_origins());
+  EXPECT_TRUE(peeler.CanPeel(loop_tree->outer_loops()[0]));
+  EXPECT_FALSE(peeler.CanUnroll(loop_tree->outer_loops()[0]));
+}
+
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,193 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/execution/warmup-profile.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "src/base/platform/platform.h"
+#include "src/execution/isolate.h"
+#include "src/execution/runtime-profiler.h"
+#include "src/heap/factory.h"
+#include "src/objects/js-function-inl.h"
+#include "src/objects/objects-inl.h"
+#include "src/objects/script-inl.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+class WarmupProfileTest : public TestWithNativeContext {
+ protected:
+  // Compiles {source}, which has to evaluate to a function, as a script with
+  // the given {name}.
+  Handle<JSFunction> RunNamedJS(const char* name, const char* source) {
+    Handle<JSFunction> function = RunJS<JSFunction>(source);
+    Script::cast(function->shared().script())
+        .set_name(*factory()->NewStringFromAsciiChecked(name));
+    return function;
+  }
+};
+
+TEST_F(WarmupProfileTest, RoundTripsRecordedFunctions) {
+  Handle<JSFunction> f =
+      RunNamedJS("app.js", "(function f(a) { return a + 1; })");
+  WarmupProfile profile;
+  profile.RecordOptimization(f->shared());
+  EXPECT_EQ(1u, profile.recorded_count());
+  EXPECT_EQ(0u, profile.hinted_count());
+  EXPECT_FALSE(profile.IsHinted(f->shared()));
+
+  std::stringstream stream;
+  profile.Write(stream);
+  WarmupProfile restored;
+  ASSERT_TRUE(restored.Read(stream));
+  EXPECT_EQ(1u, restored.hinted_count());
+  EXPECT_TRUE(restored.IsHinted(f->shared()));
+  EXPECT_TRUE(restored.TakeHint(f->shared()));
+  EXPECT_FALSE(restored.TakeHint(f->shared()));
+  // The function stays in the profile written by this run.
+  EXPECT_EQ(1u, restored.recorded_count());
+}
+
+TEST_F(WarmupProfileTest, IgnoresFunctionsOfUnnamedScripts) {
+  Handle<JSFunction> f = RunJS<JSFunction>("(function f(a) { return a; })");
+  WarmupProfile profile;
+  profile.RecordOptimization(f->shared());
+  EXPECT_EQ(0u, profile.recorded_count());
+}
+
+TEST_F(WarmupProfileTest, DoesNotHintChangedScripts) {
+  Handle<JSFunction> f =
+      RunNamedJS("app.js", "(function f(a) { return a + 2; })");
+  std::stringstream original;
+  WarmupProfile profile;
+  profile.RecordOptimization(f->shared());
+  profile.Write(original);
+
+  Handle<JSFunction> g =
+      RunNamedJS("app.js", "(function f(a) { return a + 22; })");
+  WarmupProfile restored;
+  ASSERT_TRUE(restored.Read(original));
+  EXPECT_FALSE(restored.IsHinted(g->shared()));
+}
+
+TEST_F(WarmupProfileTest, KeepsCommasInScriptNames) {
+  Handle<JSFunction> f =
+      RunNamedJS("a,b.js", "(function f(a) { return a + 3; })");
+  WarmupProfile profile;
+  profile.RecordOptimization(f->shared());
+  std::stringstream stream;
+  profile.Write(stream);
+  WarmupProfile restored;
+  ASSERT_TRUE(restored.Read(stream));
+  EXPECT_TRUE(restored.IsHinted(f->shared()));
+}
+
+TEST_F(WarmupProfileTest, RejectsMalformedProfiles) {
+  {
+    std::istringstream stream("12,0,10,app.js\n\n13,1,5,lib.js\n");
+    WarmupProfile profile;
+    EXPECT_TRUE(profile.Read(stream));
+    EXPECT_EQ(2u, profile.hinted_count());
+  }
+  {
+    std::istringstream stream("12,0\n");
+    WarmupProfile profile;
+    EXPECT_FALSE(profile.Read(stream));
+  }
+  {
+    std::istringstream stream("12,0,10,\n");
+    WarmupProfile profile;
+    EXPECT_FALSE(profile.Read(stream));
+  }
+  {
+    std::istringstream stream("12;0;10;app.js\n");
+    WarmupProfile profile;
+    EXPECT_FALSE(profile.Read(stream));
+  }
+  {
+    // Well-formed lines in front of a malformed one are not used either.
+    std::istringstream stream("12,0,10,app.js\n12,0\n");
+    WarmupProfile profile;
+    EXPECT_FALSE(profile.Read(stream));
+    EXPECT_EQ(0u, profile.hinted_count());
+    EXPECT_EQ(0u, profile.recorded_count());
+  }
+}
+
+TEST_F(WarmupProfileTest, MergesHintsIntoIndependentProfiles) {
+  Handle<JSFunction> f =
+      RunNamedJS("app.js", "(function f(a) { return a + 6; })");
+  std::stringstream stream;
+  {
+    WarmupProfile profile;
+    profile.RecordOptimization(f->shared());
+    profile.Write(stream);
+  }
+  WarmupProfile shared;
+  ASSERT_TRUE(shared.Read(stream));
+
+  WarmupProfile profile;
+  profile.Merge(shared);
+  EXPECT_EQ(1u, profile.recorded_count());
+  EXPECT_TRUE(profile.TakeHint(f->shared()));
+  // Taking the hint leaves the shared profile alone.
+  EXPECT_TRUE(shared.IsHinted(f->shared()));
+}
+
+TEST_F(WarmupProfileTest, ReplacesProfileFiles) {
+  Handle<JSFunction> f =
+      RunNamedJS("app.js", "(function f(a) { return a + 5; })");
+  std::string pid = std::to_string(base::OS::GetCurrentProcessId());
+  std::string filename = "warmup-profile-unittest-" + pid + ".txt";
+  {
+    std::ofstream file(filename);
+    file << "12,0\n";
+  }
+  WarmupProfile profile;
+  profile.RecordOptimization(f->shared());
+  ASSERT_TRUE(profile.WriteToFile(filename.c_str()));
+
+  WarmupProfile restored;
+  EXPECT_TRUE(restored.ReadFromFile(filename.c_str()));
+  EXPECT_TRUE(restored.IsHinted(f->shared()));
+  // The file that was moved over the profile is gone.
+  EXPECT_FALSE(std::ifstream(filename + ".tmp." + pid).good());
+  std::remove(filename.c_str());
+}
+
+TEST_F(WarmupProfileTest, OptimizesHintedFunctionsEarly) {
+  // The hint is applied when the feedback vector is allocated, and taken
+  // at the first profiler tick of the interpreted function.
+  if (!FLAG_opt || FLAG_always_opt || !FLAG_lazy_feedback_allocation) return;
+  Handle<JSFunction> f =
+      RunNamedJS("app.js", "var f = function(a) { return a + 4; }; f");
+  std::stringstream stream;
+  {
+    WarmupProfile profile;
+    profile.RecordOptimization(f->shared());
+    profile.Write(stream);
+  }
+  auto profile = std::make_unique<WarmupProfile>();
+  ASSERT_TRUE(profile->Read(stream));
+  WarmupProfile* hints = profile.get();
+  i_isolate()->runtime_profiler()->SetWarmupProfileForTesting(
+      std::move(profile));
+
+  // Far fewer calls than it takes to exhaust the regular interrupt budget.
+  RunJS("for (let i = 0; i < 5000; i++) f(i);");
+  EXPECT_EQ(0u, hints->hinted_count());
+  EXPECT_TRUE(f->HasOptimizationMarker() || f->HasAvailableOptimizedCode());
+
+  i_isolate()->runtime_profiler()->SetWarmupProfileForTesting(nullptr);
+}
+
+}  // namespace internal
+}  // namespace v8
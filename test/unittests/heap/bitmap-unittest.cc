@@ -158,5 +158,57 @@ TEST_F(NonAtomicBitmapTest, ClearMultipleRanges) {
                                 Bitmap::kBitsPerCell * 3));
 }
 
+TEST_F(NonAtomicBitmapTest, FindNonZeroCell) {
+  auto bm = bitmap();
+  const uint32_t cells_count = static_cast<uint32_t>(Bitmap::CellsCount());
+  EXPECT_EQ(cells_count, Bitmap::FindNonZeroCell(bm->cells(), 0, cells_count));
+  // Probe every position within and around a vector width.
+  for (uint32_t cell : {0u, 1u, 2u, 3u, 4u, 5u, 7u, 8u, 100u,
+                        cells_count - 1}) {
+    bm->cells()[cell] = 1u << (cell % Bitmap::kBitsPerCell);
+    EXPECT_EQ(cell, Bitmap::FindNonZeroCell(bm->cells(), 0, cells_count));
+    if (cell > 0) {
+      EXPECT_EQ(cell, Bitmap::FindNonZeroCell(bm->cells(), cell, cells_count));
+      EXPECT_EQ(cell, Bitmap::FindNonZeroCell(bm->cells(), 0, cell));
+    }
+    EXPECT_EQ(cells_count,
+              Bitmap::FindNonZeroCell(bm->cells(), cell + 1, cells_count));
+    bm->cells()[cell] = 0;
+  }
+}
+
+TEST_F(NonAtomicBitmapTest, AllBitsClearInRangeLong) {
+  auto bm = bitmap();
+  const uint32_t kStart = 3;
+  const uint32_t kEnd = Bitmap::kBitsPerCell * 40 + 5;
+  EXPECT_TRUE(bm->AllBitsClearInRange(kStart, kEnd));
+  bm->SetRange(Bitmap::kBitsPerCell * 17 + 9, Bitmap::kBitsPerCell * 17 + 10);
+  EXPECT_FALSE(bm->AllBitsClearInRange(kStart, kEnd));
+  EXPECT_TRUE(bm->AllBitsClearInRange(kStart, Bitmap::kBitsPerCell * 17 + 9));
+  EXPECT_TRUE(bm->AllBitsClearInRange(Bitmap::kBitsPerCell * 17 + 10, kEnd));
+}
+
+TEST_F(NonAtomicBitmapTest, FindNonZeroCellWalk) {
+  auto bm = bitmap();
+  const uint32_t cells_count = static_cast<uint32_t>(Bitmap::CellsCount());
+  for (uint32_t stride : {1u, 3u, 16u, 256u, cells_count}) {
+    bm->Clear();
+    for (uint32_t cell = stride - 1; cell < cells_count; cell += stride) {
+      bm->cells()[cell] = 1;
+    }
+    // Walking from one non-zero cell to the next visits exactly the marked
+    // cells.
+    uint32_t expected = stride - 1;
+    uint32_t cell = Bitmap::FindNonZeroCell(bm->cells(), 0, cells_count);
+    while (cell < cells_count) {
+      EXPECT_EQ(expected, cell);
+      expected += stride;
+      cell = Bitmap::FindNonZeroCell(bm->cells(), cell + 1, cells_count);
+    }
+    EXPECT_EQ(cells_count, cell);
+    EXPECT_LE(cells_count, expected);
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
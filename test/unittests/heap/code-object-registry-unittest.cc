@@ -89,5 +89,25 @@ TEST(CodeObjectRegistry, FindAlternatingObjects) {
     }
   }
 }
+
+TEST(CodeObjectRegistry, ReinitializeFrom) {
+  CodeObjectRegistry registry;
+  const int elements = 10;
+  const int offset = 100;
+  for (int i = 1; i <= elements; i++) {
+    registry.RegisterNewlyAllocatedCodeObject(i * offset);
+  }
+
+  // Only the even objects survive sweeping.
+  std::vector<Address> code_objects;
+  for (int i = 2; i <= elements; i += 2) {
+    code_objects.push_back(i * offset);
+  }
+  registry.ReinitializeFrom(std::move(code_objects));
+
+  for (int i = 1; i <= elements; i++) {
+    CHECK_EQ(registry.Contains(i * offset), i % 2 == 0);
+  }
+}
 }  // namespace internal
 }  // namespace v8
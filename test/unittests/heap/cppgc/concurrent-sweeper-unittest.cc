@@ -215,6 +215,24 @@ TEST_F(ConcurrentSweeperTest, BackgroundSweepOfLargePage) {
   FinishSweeping();
 }
 
+TEST_F(ConcurrentSweeperTest, BackgroundReleaseOfEmptyNormalPage) {
+  // Empty pages without finalizable objects are released by the concurrent
+  // sweeper.
+  using GCedType = NormalNonFinalizable;
+
+  auto* object = MakeGarbageCollected<GCedType>(GetAllocationHandle());
+  auto* page = BasePage::FromPayload(object);
+
+  StartSweeping();
+
+  // Wait for concurrent sweeping to finish.
+  WaitForConcurrentSweeping();
+
+  CheckPageRemoved(page);
+
+  FinishSweeping();
+}
+
 TEST_F(ConcurrentSweeperTest, DeferredFinalizationOfNormalPage) {
   static constexpr size_t kNumberOfObjects = 10;
   // Finalizable types are left intact by concurrent sweeper.
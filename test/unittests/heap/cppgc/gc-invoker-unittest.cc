@@ -114,6 +114,26 @@ TEST(GCInvokerTest, ConservativeGCIsInvokedAsPreciseGCViaPlatform) {
   platform.RunAllForegroundTasks();
 }
 
+TEST(GCInvokerTest, MinorGCIsScheduledAsPreciseGCViaPlatform) {
+  // Minor GCs cannot scan the stack even if conservative stack scanning is
+  // supported.
+  std::shared_ptr<cppgc::TaskRunner> runner =
+      std::shared_ptr<cppgc::TaskRunner>(new MockTaskRunner());
+  MockPlatform platform(runner);
+  MockGarbageCollector gc;
+  GCInvoker invoker(&gc, &platform,
+                    cppgc::Heap::StackSupport::kSupportsConservativeStackScan);
+  EXPECT_CALL(gc, CollectGarbage).Times(0);
+  EXPECT_CALL(gc, epoch).WillOnce(::testing::Return(0));
+  EXPECT_CALL(*static_cast<MockTaskRunner*>(runner.get()),
+              PostNonNestableTask(::testing::_));
+  GarbageCollector::Config config =
+      GarbageCollector::Config::MinorPreciseAtomicConfig();
+  config.stack_state =
+      GarbageCollector::Config::StackState::kMayContainHeapPointers;
+  invoker.CollectGarbage(config);
+}
+
 TEST(GCInvokerTest, IncrementalGCIsStarted) {
   // Since StartIncrementalGarbageCollection doesn't scan the stack, support for
   // conservative stack scanning should not matter.
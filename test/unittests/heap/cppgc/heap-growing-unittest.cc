@@ -155,5 +155,24 @@ TEST(HeapGrowingTest, IncrementalGCFinalized) {
   FakeAllocate(&stats_collector, StatsCollector::kAllocationThresholdBytes);
 }
 
+#if defined(CPPGC_YOUNG_GENERATION)
+TEST(HeapGrowingTest, MinorGCTriggered) {
+  StatsCollector stats_collector;
+  MockGarbageCollector gc;
+  cppgc::Heap::ResourceConstraints constraints;
+  // Keep the limits for major GCs far away.
+  constraints.initial_heap_size_bytes = 100 * HeapGrowing::kYoungGenerationSize;
+  HeapGrowing growing(&gc, &stats_collector, constraints,
+                      cppgc::Heap::MarkingType::kIncrementalAndConcurrent,
+                      cppgc::Heap::SweepingType::kIncrementalAndConcurrent);
+  EXPECT_EQ(HeapGrowing::kYoungGenerationSize, growing.limit_for_minor_gc());
+  EXPECT_CALL(gc, StartIncrementalGarbageCollection(::testing::_)).Times(0);
+  EXPECT_CALL(gc, CollectGarbage(::testing::Field(
+                      &GarbageCollector::Config::collection_type,
+                      GarbageCollector::Config::CollectionType::kMinor)));
+  FakeAllocate(&stats_collector, HeapGrowing::kYoungGenerationSize + 1);
+}
+#endif  // defined(CPPGC_YOUNG_GENERATION)
+
 }  // namespace internal
 }  // namespace cppgc
@@ -191,6 +191,28 @@ TYPED_TEST(MinorGCTestForType, InterGenerationalPointerForDifferentPageTypes) {
       this, this->GetHeap());
 }
 
+TYPED_TEST(MinorGCTestForType, ClearedRememberedSlotIsIgnored) {
+  using Type = typename TestFixture::Type;
+
+  Persistent<Type> old =
+      MakeGarbageCollected<Type>(this->GetAllocationHandle());
+  TestFixture::CollectMinor();
+  EXPECT_FALSE(HeapObjectHeader::FromPayload(old.Get()).IsYoung());
+
+  const auto& set = Heap::From(this->GetHeap())->remembered_slots();
+  const size_t set_size_before_barrier = set.size();
+
+  // The slot stays in the remembered set after it is cleared.
+  old->next = MakeGarbageCollected<Type>(this->GetAllocationHandle());
+  EXPECT_EQ(set_size_before_barrier + 1u, set.size());
+  old->next = static_cast<Type*>(nullptr);
+  EXPECT_EQ(set_size_before_barrier + 1u, set.size());
+
+  TestFixture::CollectMinor();
+  EXPECT_EQ(1u, TestFixture::DestructedObjects());
+  EXPECT_TRUE(set.empty());
+}
+
 TYPED_TEST(MinorGCTestForType, OmitGenerationalBarrierForOnStackObject) {
   using Type = typename TestFixture::Type;
 
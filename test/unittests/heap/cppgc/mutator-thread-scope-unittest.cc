@@ -0,0 +1,145 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "include/cppgc/mutator-thread-scope.h"
+
+#include <atomic>
+#include <functional>
+
+#include "include/cppgc/allocation.h"
+#include "include/cppgc/cross-thread-persistent.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
+#include "src/heap/cppgc/heap.h"
+#include "test/unittests/heap/cppgc/tests.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cppgc {
+namespace internal {
+
+namespace {
+
+struct GCed final : GarbageCollected<GCed> {
+  static size_t destructor_call_count;
+  ~GCed() { destructor_call_count++; }
+  void Trace(cppgc::Visitor*) const {}
+  int a = 0;
+};
+size_t GCed::destructor_call_count = 0;
+
+class Runner final : public v8::base::Thread {
+ public:
+  template <typename Callback>
+  explicit Runner(Callback callback)
+      : Thread(v8::base::Thread::Options("MutatorThreadScope Thread")),
+        callback_(callback) {}
+
+  void Run() final { callback_(); }
+
+ private:
+  std::function<void()> callback_;
+};
+
+class MutatorThreadScopeTest : public testing::TestWithPlatform {
+ public:
+  MutatorThreadScopeTest() {
+    Heap::HeapOptions options;
+    options.marking_support = Heap::MarkingType::kAtomic;
+    options.supports_attached_threads = true;
+    heap_ = Heap::Create(platform_, std::move(options));
+    GCed::destructor_call_count = 0;
+  }
+
+  void PreciseGC() {
+    heap_->ForceGarbageCollectionSlow(
+        ::testing::UnitTest::GetInstance()->current_test_info()->name(),
+        "Testing", cppgc::Heap::StackState::kNoHeapPointers);
+  }
+
+  cppgc::Heap* GetHeap() const { return heap_.get(); }
+  Safepoint& safepoint() { return Heap::From(GetHeap())->safepoint(); }
+
+ private:
+  std::unique_ptr<cppgc::Heap> heap_;
+};
+
+}  // namespace
+
+TEST_F(MutatorThreadScopeTest, AllocateOnAttachedThread) {
+  static constexpr size_t kNumObjects = 1000;
+  subtle::CrossThreadPersistent<GCed> holder;
+  Runner runner([this, &holder]() {
+    subtle::MutatorThreadScope scope(GetHeap());
+    for (size_t i = 0; i < kNumObjects; ++i) {
+      holder = MakeGarbageCollected<GCed>(scope.GetAllocationHandle());
+    }
+  });
+  runner.StartSynchronously();
+  runner.Join();
+  EXPECT_EQ(0u, safepoint().attached_threads());
+  EXPECT_TRUE(holder);
+  PreciseGC();
+  EXPECT_EQ(kNumObjects - 1, GCed::destructor_call_count);
+  holder.Clear();
+  PreciseGC();
+  EXPECT_EQ(kNumObjects, GCed::destructor_call_count);
+}
+
+TEST_F(MutatorThreadScopeTest, GarbageCollectionWaitsForSafepoint) {
+  subtle::CrossThreadPersistent<GCed> holder;
+  v8::base::Semaphore attached(0);
+  std::atomic<bool> done{false};
+  size_t allocated_after_gc = 0;
+  Runner runner([this, &holder, &attached, &done, &allocated_after_gc]() {
+    subtle::MutatorThreadScope scope(GetHeap());
+    holder = MakeGarbageCollected<GCed>(scope.GetAllocationHandle());
+    // Leave an unused part in the buffer that the garbage collection has to
+    // release.
+    MakeGarbageCollected<GCed>(scope.GetAllocationHandle());
+    attached.Signal();
+    while (!done.load(std::memory_order_relaxed)) {
+      scope.Safepoint();
+    }
+    MakeGarbageCollected<GCed>(scope.GetAllocationHandle());
+    allocated_after_gc++;
+  });
+  runner.Start();
+  attached.Wait();
+  EXPECT_EQ(1u, safepoint().attached_threads());
+  PreciseGC();
+  EXPECT_EQ(1u, GCed::destructor_call_count);
+  EXPECT_TRUE(holder);
+  done.store(true, std::memory_order_relaxed);
+  runner.Join();
+  EXPECT_EQ(1u, allocated_after_gc);
+  holder.Clear();
+  PreciseGC();
+  EXPECT_EQ(3u, GCed::destructor_call_count);
+}
+
+TEST_F(MutatorThreadScopeTest, ParkedThreadDoesNotBlockGarbageCollection) {
+  v8::base::Semaphore parked(0);
+  v8::base::Semaphore gc_done(0);
+  Runner runner([this, &parked, &gc_done]() {
+    subtle::MutatorThreadScope scope(GetHeap());
+    MakeGarbageCollected<GCed>(scope.GetAllocationHandle());
+    {
+      subtle::MutatorThreadScope::ParkedScope parked_scope(scope);
+      parked.Signal();
+      gc_done.Wait();
+    }
+    MakeGarbageCollected<GCed>(scope.GetAllocationHandle());
+  });
+  runner.Start();
+  parked.Wait();
+  PreciseGC();
+  EXPECT_EQ(1u, GCed::destructor_call_count);
+  gc_done.Signal();
+  runner.Join();
+  PreciseGC();
+  EXPECT_EQ(2u, GCed::destructor_call_count);
+}
+
+}  // namespace internal
+}  // namespace cppgc
@@ -51,6 +51,20 @@ TEST_F(StatsCollectorTest, EventPrevGCMarkedObjectSize) {
   EXPECT_EQ(1024u, event.marked_bytes);
 }
 
+TEST_F(StatsCollectorTest, MinorGCRetainsOldObjects) {
+  stats.NotifyMarkingStarted(GarbageCollector::Config::CollectionType::kMajor,
+                             GarbageCollector::Config::IsForcedGC::kNotForced);
+  stats.NotifyMarkingCompleted(1024);
+  stats.NotifySweepingCompleted();
+  // Minor GCs only report the marked bytes of young objects.
+  stats.NotifyMarkingStarted(GarbageCollector::Config::CollectionType::kMinor,
+                             GarbageCollector::Config::IsForcedGC::kNotForced);
+  stats.NotifyMarkingCompleted(512);
+  EXPECT_EQ(1536u, stats.allocated_object_size());
+  stats.NotifySweepingCompleted();
+  EXPECT_EQ(1536u, stats.GetPreviousEventForTesting().marked_bytes);
+}
+
 TEST_F(StatsCollectorTest, AllocationNoReportBelowAllocationThresholdBytes) {
   constexpr size_t kObjectSize = 17;
   EXPECT_LT(kObjectSize, StatsCollector::kAllocationThresholdBytes);
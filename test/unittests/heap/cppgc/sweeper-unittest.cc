@@ -5,8 +5,10 @@
 #include "src/heap/cppgc/sweeper.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "include/cppgc/allocation.h"
+#include "include/cppgc/internal/gc-info.h"
 #include "include/cppgc/persistent.h"
 #include "src/heap/cppgc/globals.h"
 #include "src/heap/cppgc/heap-object-header.h"
@@ -269,5 +271,52 @@ TEST_F(SweeperTest, UnmarkObjects) {
 #endif
 }
 
+namespace {
+
+std::vector<int> g_finalized_types;
+
+template <int Type>
+class RecordingFinalizable final
+    : public GarbageCollected<RecordingFinalizable<Type>> {
+ public:
+  ~RecordingFinalizable() { g_finalized_types.push_back(Type); }
+
+  void Trace(cppgc::Visitor*) const {}
+};
+
+}  // namespace
+
+TEST_F(SweeperTest, FinalizersAreGroupedByType) {
+  static constexpr size_t kObjectsPerType = 16;
+  using TypeA = RecordingFinalizable<0>;
+  using TypeB = RecordingFinalizable<1>;
+  g_finalized_types.clear();
+  // Interleave allocations of both types on the same pages.
+  for (size_t i = 0; i < kObjectsPerType; ++i) {
+    MakeGarbageCollected<TypeA>(GetAllocationHandle());
+    MakeGarbageCollected<TypeB>(GetAllocationHandle());
+  }
+
+  Sweep();
+
+  ASSERT_EQ(2 * kObjectsPerType, g_finalized_types.size());
+  size_t type_changes = 0;
+  for (size_t i = 1; i < g_finalized_types.size(); ++i) {
+    if (g_finalized_types[i] != g_finalized_types[i - 1]) type_changes++;
+  }
+  EXPECT_EQ(1u, type_changes);
+
+  const auto& finalizer_stats = Heap::From(GetHeap())
+                                    ->stats_collector()
+                                    ->GetPreviousEventForTesting()
+                                    .finalizer_stats;
+  for (GCInfoIndex index :
+       {GCInfoTrait<TypeA>::Index(), GCInfoTrait<TypeB>::Index()}) {
+    auto it = finalizer_stats.find(index);
+    ASSERT_NE(finalizer_stats.end(), it);
+    EXPECT_EQ(kObjectsPerType, it->second.invocations);
+  }
+}
+
 }  // namespace internal
 }  // namespace cppgc
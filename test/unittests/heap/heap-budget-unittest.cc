@@ -0,0 +1,145 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-budget.h"
+
+#include "include/libplatform/libplatform.h"
+#include "src/execution/isolate.h"
+#include "src/heap/heap.h"
+#include "src/heap/incremental-marking.h"
+#include "src/init/v8.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+using HeapBudgetTest = TestWithIsolate;
+
+namespace {
+
+Heap* HeapOf(const IsolateWrapper& isolate) {
+  return reinterpret_cast<Isolate*>(isolate.isolate())->heap();
+}
+
+}  // namespace
+
+TEST_F(HeapBudgetTest, Available) {
+  IsolateWrapper other_isolate(kNoCounters);
+  Heap* heap = i_isolate()->heap();
+  Heap* other_heap = HeapOf(other_isolate);
+  HeapBudget budget(100 * MB, nullptr, nullptr);
+  budget.Register(heap);
+  budget.Register(other_heap);
+
+  EXPECT_EQ(100 * MB, budget.UpdateAndGetAvailable(heap, 30 * MB));
+  EXPECT_EQ(70 * MB, budget.UpdateAndGetAvailable(other_heap, 40 * MB));
+  EXPECT_EQ(60 * MB, budget.Available(heap));
+  EXPECT_EQ(70 * MB, budget.Used());
+
+  budget.UpdateAndGetAvailable(other_heap, 120 * MB);
+  EXPECT_EQ(0u, budget.Available(heap));
+
+  budget.Unregister(other_heap);
+  EXPECT_EQ(100 * MB, budget.Available(heap));
+  EXPECT_EQ(30 * MB, budget.Used());
+  budget.Unregister(heap);
+}
+
+TEST_F(HeapBudgetTest, ReduceMemoryOfLargestHeapsFirst) {
+  IsolateWrapper large_isolate(kNoCounters);
+  IsolateWrapper small_isolate(kNoCounters);
+  Heap* heap = i_isolate()->heap();
+  Heap* large_heap = HeapOf(large_isolate);
+  Heap* small_heap = HeapOf(small_isolate);
+  HeapBudget budget(100 * MB, nullptr, nullptr);
+  budget.Register(heap);
+  budget.Register(small_heap);
+  budget.Register(large_heap);
+
+  budget.UpdateAndGetAvailable(heap, 10 * MB);
+  budget.UpdateAndGetAvailable(small_heap, 20 * MB);
+  budget.UpdateAndGetAvailable(large_heap, 50 * MB);
+  // Below the threshold nobody is asked to reduce memory.
+  EXPECT_EQ(0, budget.ReduceMemoryOfLargestHeaps(heap));
+  EXPECT_FALSE(large_heap->HighMemoryPressure());
+
+  // The overshoot of 5 MB over the threshold is covered by the large heap.
+  budget.UpdateAndGetAvailable(large_heap, 65 * MB);
+  EXPECT_EQ(1, budget.ReduceMemoryOfLargestHeaps(heap));
+  // The notification is delivered as a task on the thread of the large heap.
+  EXPECT_FALSE(large_heap->HighMemoryPressure());
+  {
+    v8::Isolate::Scope isolate_scope(large_isolate.isolate());
+    while (platform::PumpMessageLoop(V8::GetCurrentPlatform(),
+                                     large_isolate.isolate())) {
+      continue;
+    }
+  }
+  if (FLAG_incremental_marking) {
+    EXPECT_FALSE(large_heap->incremental_marking()->IsStopped());
+  }
+  EXPECT_TRUE(small_heap->incremental_marking()->IsStopped());
+  EXPECT_TRUE(heap->incremental_marking()->IsStopped());
+
+  // The large heap is not notified again until it grows further.
+  EXPECT_EQ(0, budget.ReduceMemoryOfLargestHeaps(heap));
+  budget.UpdateAndGetAvailable(large_heap, 66 * MB);
+  EXPECT_EQ(1, budget.ReduceMemoryOfLargestHeaps(heap));
+
+  // Once the pressure has gone away, it can be notified again.
+  budget.UpdateAndGetAvailable(large_heap, 50 * MB);
+  EXPECT_EQ(0, budget.ReduceMemoryOfLargestHeaps(heap));
+  budget.UpdateAndGetAvailable(large_heap, 65 * MB);
+  EXPECT_EQ(1, budget.ReduceMemoryOfLargestHeaps(heap));
+
+  budget.Unregister(large_heap);
+  budget.Unregister(small_heap);
+  budget.Unregister(heap);
+}
+
+namespace {
+
+size_t RaiseBudget(void* data, v8::Isolate* isolate, size_t current_budget,
+                   size_t used) {
+  int* invocations = static_cast<int*>(data);
+  (*invocations)++;
+  return current_budget + used;
+}
+
+size_t KeepBudget(void* data, v8::Isolate* isolate, size_t current_budget,
+                  size_t used) {
+  return current_budget;
+}
+
+}  // namespace
+
+TEST_F(HeapBudgetTest, ExhaustedCallback) {
+  Heap* heap = i_isolate()->heap();
+  int invocations = 0;
+  HeapBudget budget(10 * MB, &RaiseBudget, &invocations);
+  budget.Register(heap);
+  budget.UpdateAndGetAvailable(heap, 10 * MB);
+  EXPECT_TRUE(budget.InvokeExhaustedCallback(heap));
+  EXPECT_EQ(1, invocations);
+  EXPECT_EQ(20 * MB, budget.Budget());
+  EXPECT_EQ(20 * MB, budget.Available(heap));
+  budget.Unregister(heap);
+
+  // A callback that neither raises the budget nor frees memory does not
+  // prevent the out-of-memory error.
+  HeapBudget fixed_budget(10 * MB, &KeepBudget, nullptr);
+  fixed_budget.Register(heap);
+  fixed_budget.UpdateAndGetAvailable(heap, 10 * MB);
+  EXPECT_FALSE(fixed_budget.InvokeExhaustedCallback(heap));
+  fixed_budget.Unregister(heap);
+
+  HeapBudget no_callback_budget(10 * MB, nullptr, nullptr);
+  no_callback_budget.Register(heap);
+  EXPECT_FALSE(no_callback_budget.InvokeExhaustedCallback(heap));
+  no_callback_budget.Unregister(heap);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -12,6 +12,7 @@
 #include "src/handles/handles-inl.h"
 #include "src/handles/handles.h"
 
+#include "src/heap/heap-budget.h"
 #include "src/heap/heap-controller.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -108,5 +109,93 @@ TEST_F(MemoryControllerTest, OldGenerationAllocationLimit) {
           new_space_capacity, factor, Heap::HeapGrowingMode::kMinimal));
 }
 
+TEST_F(MemoryControllerTest, OldGenerationAllocationLimitWithinBudget) {
+  Heap* heap = i_isolate()->heap();
+  IsolateWrapper other_isolate(kNoCounters);
+  Heap* other_heap =
+      reinterpret_cast<Isolate*>(other_isolate.isolate())->heap();
+  std::shared_ptr<v8::HeapBudget> budget = v8::HeapBudget::New(512 * MB);
+  heap->ConfigureHeapBudget(budget);
+  other_heap->ConfigureHeapBudget(budget);
+  HeapBudget* heap_budget = heap->heap_budget();
+
+  size_t old_gen_size = 128 * MB;
+  size_t max_old_generation_size = 512 * MB;
+  size_t new_space_capacity = 16 * MB;
+  double factor = V8HeapTrait::kMinGrowingFactor;
+  Heap::HeapGrowingMode mode = Heap::HeapGrowingMode::kMinimal;
+  size_t unconstrained_limit =
+      static_cast<size_t>(old_gen_size * factor + new_space_capacity);
+
+  // The other heap leaves enough room.
+  heap_budget->UpdateAndGetAvailable(other_heap, 64 * MB);
+  EXPECT_EQ(unconstrained_limit,
+            V8Controller::CalculateAllocationLimit(
+                heap, old_gen_size, 0u, max_old_generation_size,
+                new_space_capacity, factor, mode));
+  EXPECT_EQ(old_gen_size + 64 * MB, heap_budget->Used());
+
+  // The other heap uses up the budget, so the heap only gets a minimal step.
+  heap_budget->UpdateAndGetAvailable(other_heap, 512 * MB);
+  EXPECT_EQ(old_gen_size +
+                V8Controller::MinimumAllocationLimitGrowingStep(mode),
+            V8Controller::CalculateAllocationLimit(
+                heap, old_gen_size, 0u, max_old_generation_size,
+                new_space_capacity, factor, mode));
+}
+
+using NewSpaceControllerTest = TestWithIsolate;
+
+TEST_F(NewSpaceControllerTest, MaxCapacityForPause) {
+  // 1 ms at 1 MB/ms with 10% survival allows 10 MB.
+  EXPECT_EQ(10 * MB,
+            NewSpaceController::MaxCapacityForPause(10.0, 1.0 * MB, 1.0));
+  // Doubling the survival rate halves the capacity.
+  EXPECT_EQ(5 * MB,
+            NewSpaceController::MaxCapacityForPause(20.0, 1.0 * MB, 1.0));
+  // Without a target or speed estimate the capacity is unbounded.
+  EXPECT_EQ(std::numeric_limits<size_t>::max(),
+            NewSpaceController::MaxCapacityForPause(10.0, 1.0 * MB, 0.0));
+  EXPECT_EQ(std::numeric_limits<size_t>::max(),
+            NewSpaceController::MaxCapacityForPause(10.0, 0.0, 1.0));
+}
+
+TEST_F(NewSpaceControllerTest, TargetCapacity) {
+  Heap* heap = i_isolate()->heap();
+  const size_t min_capacity = 1 * MB;
+  const size_t max_capacity = 16 * MB;
+  const size_t current_capacity = 4 * MB;
+  const double fast_speed = 1000.0 * MB;
+  const int factor = FLAG_semi_space_growth_factor;
+
+  // Low survival shrinks.
+  EXPECT_EQ(current_capacity / factor,
+            NewSpaceController::CalculateTargetCapacity(
+                heap, current_capacity, min_capacity, max_capacity, 5.0,
+                fast_speed, 1.0));
+  // Moderate survival keeps the capacity.
+  EXPECT_EQ(current_capacity, NewSpaceController::CalculateTargetCapacity(
+                                  heap, current_capacity, min_capacity,
+                                  max_capacity, 15.0, fast_speed, 1.0));
+  // High survival grows.
+  EXPECT_EQ(current_capacity * factor,
+            NewSpaceController::CalculateTargetCapacity(
+                heap, current_capacity, min_capacity, max_capacity, 30.0,
+                fast_speed, 1.0));
+  // Growing is bounded by the maximum capacity.
+  EXPECT_EQ(max_capacity, NewSpaceController::CalculateTargetCapacity(
+                              heap, max_capacity, min_capacity, max_capacity,
+                              30.0, fast_speed, 1.0));
+  // Shrinking is bounded by the minimum capacity.
+  EXPECT_EQ(min_capacity, NewSpaceController::CalculateTargetCapacity(
+                              heap, min_capacity, min_capacity, max_capacity,
+                              5.0, fast_speed, 1.0));
+  // A slow scavenger caps the capacity to fit into the pause target:
+  // 1 ms at 512 KB/ms with 25% survival allows 2 MB.
+  EXPECT_EQ(2 * MB, NewSpaceController::CalculateTargetCapacity(
+                        heap, current_capacity, min_capacity, max_capacity,
+                        25.0, 512.0 * KB, 1.0));
+}
+
 }  // namespace internal
 }  // namespace v8
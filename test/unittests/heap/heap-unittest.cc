@@ -9,8 +9,11 @@
 #include <limits>
 
 #include "src/handles/handles-inl.h"
+#include "src/heap/incremental-marking.h"
+#include "src/heap/mark-compact.h"
 #include "src/heap/memory-chunk.h"
 #include "src/heap/safepoint.h"
+#include "src/heap/scavenge-job.h"
 #include "src/heap/spaces-inl.h"
 #include "src/objects/objects-inl.h"
 #include "test/unittests/test-utils.h"
@@ -96,6 +99,26 @@ TEST(Heap, HeapSizeFromPhysicalMemory) {
       i::Heap::HeapSizeFromPhysicalMemory(static_cast<uint64_t>(8192u) * MB));
 }
 
+TEST(Heap, EvacuationCostModel) {
+  const size_t KB = static_cast<size_t>(i::KB);
+  // 1MB/ms compaction speed, 1ms budget.
+  EvacuationCostModel model(1024.0 * KB, 1.0);
+  EXPECT_DOUBLE_EQ(0.25, model.CostInMs(256 * KB, 0));
+  EXPECT_LT(model.CostInMs(256 * KB, 0), model.CostInMs(256 * KB, 1000));
+  EXPECT_DOUBLE_EQ(1024.0 * KB, model.MinReclaimedBytesPerMs());
+
+  // Mostly empty pages are worth evacuating, mostly full ones are not.
+  EXPECT_TRUE(model.IsWorthEvacuating(192 * KB, model.CostInMs(64 * KB, 0)));
+  EXPECT_FALSE(model.IsWorthEvacuating(64 * KB, model.CostInMs(192 * KB, 0)));
+  // Pages exceeding the budget on their own are never selected.
+  EXPECT_FALSE(model.IsWorthEvacuating(4096 * KB, 1.5));
+
+  // Slots to update raise the bar.
+  EXPECT_TRUE(model.IsWorthEvacuating(128 * KB, model.CostInMs(96 * KB, 0)));
+  EXPECT_FALSE(
+      model.IsWorthEvacuating(128 * KB, model.CostInMs(96 * KB, 16 * KB)));
+}
+
 TEST_F(HeapTest, ASLR) {
 #if V8_TARGET_ARCH_X64
 #if V8_OS_MACOSX
@@ -135,6 +158,24 @@ TEST_F(HeapTest, ExternalLimitStaysAboveDefaultForExplicitHandling) {
   EXPECT_GE(heap->external_memory_limit(), kExternalAllocationSoftLimit);
 }
 
+TEST_F(HeapTest, PauseBudget) {
+  Heap* heap = i_isolate()->heap();
+  EXPECT_EQ(0.0, heap->pause_budget_in_ms());
+  const size_t default_trigger =
+      ScavengeJob::YoungGenerationTaskTriggerSize(heap);
+  v8_isolate()->SetGarbageCollectionPauseBudget(2.0);
+  EXPECT_EQ(2.0, heap->pause_budget_in_ms());
+  EXPECT_EQ(2.0, heap->YoungGenerationPauseTargetInMs());
+  EXPECT_LE(ScavengeJob::YoungGenerationTaskTriggerSize(heap),
+            default_trigger);
+  EXPECT_EQ(1.0, heap->incremental_marking()->BudgetedStepSizeInMs(1.0));
+  EXPECT_EQ(2.0, heap->incremental_marking()->BudgetedStepSizeInMs(5.0));
+  v8_isolate()->SetGarbageCollectionPauseBudget(0.0);
+  EXPECT_EQ(0.0, heap->pause_budget_in_ms());
+  EXPECT_EQ(default_trigger, ScavengeJob::YoungGenerationTaskTriggerSize(heap));
+  EXPECT_EQ(5.0, heap->incremental_marking()->BudgetedStepSizeInMs(5.0));
+}
+
 #ifdef V8_COMPRESS_POINTERS
 TEST_F(HeapTest, HeapLayout) {
   // Produce some garbage.
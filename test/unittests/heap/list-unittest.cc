@@ -90,6 +90,27 @@ TEST(List, InsertMultipleAtTailAndRemoveFromMiddle) {
   EXPECT_TRUE(list.Empty());
 }
 
+TEST(List, InsertBefore) {
+  List<TestChunk> list;
+  TestChunk t1, t2, t3;
+  list.PushBack(&t1);
+  list.PushBack(&t2);
+  list.InsertBefore(&t3, &t2);
+  EXPECT_EQ(list.front(), &t1);
+  EXPECT_EQ(t1.list_node().next(), &t3);
+  EXPECT_EQ(t3.list_node().next(), &t2);
+  EXPECT_EQ(t2.list_node().prev(), &t3);
+  EXPECT_EQ(list.back(), &t2);
+  list.Remove(&t3);
+  list.InsertBefore(&t3, &t1);
+  EXPECT_EQ(list.front(), &t3);
+  EXPECT_EQ(t3.list_node().next(), &t1);
+  list.Remove(&t1);
+  list.Remove(&t2);
+  list.Remove(&t3);
+  EXPECT_TRUE(list.Empty());
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
@@ -9,6 +9,7 @@
 
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap.h"
+#include "src/heap/marking-visitor-inl.h"
 #include "src/heap/marking-worklist-inl.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -133,5 +134,76 @@ TEST_F(MarkingWorklistTest, ContextWorklistCrossTask) {
   holder.ReleaseContextWorklists();
 }
 
+TEST_F(MarkingWorklistTest, PrefetchQueueDisabled) {
+  MarkingWorklists holder;
+  MarkingWorklists::Local worklists(&holder);
+  ReadOnlyRoots roots(i_isolate()->heap());
+  worklists.Push(roots.undefined_value());
+  worklists.Push(roots.null_value());
+  MarkingPrefetchQueue queue(0);
+  auto pop = [&worklists](HeapObject* object) {
+    return worklists.Pop(object);
+  };
+  HeapObject popped_object;
+  EXPECT_TRUE(queue.Pop(pop, &popped_object));
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_FALSE(worklists.IsEmpty());
+  EXPECT_TRUE(queue.Pop(pop, &popped_object));
+  EXPECT_FALSE(queue.Pop(pop, &popped_object));
+}
+
+TEST_F(MarkingWorklistTest, PrefetchQueueFillsUpToDistance) {
+  MarkingWorklists holder;
+  MarkingWorklists::Local worklists(&holder);
+  ReadOnlyRoots roots(i_isolate()->heap());
+  HeapObject objects[] = {roots.undefined_value(), roots.null_value(),
+                          roots.true_value(), roots.false_value()};
+  for (HeapObject object : objects) worklists.Push(object);
+  MarkingPrefetchQueue queue(2);
+  auto pop = [&worklists](HeapObject* object) {
+    return worklists.Pop(object);
+  };
+  // The worklist is LIFO, the queue hands out objects in the order in which
+  // they were popped.
+  HeapObject popped_object;
+  EXPECT_TRUE(queue.Pop(pop, &popped_object));
+  EXPECT_EQ(objects[3], popped_object);
+  EXPECT_EQ(1, queue.size());
+  EXPECT_TRUE(queue.Pop(pop, &popped_object));
+  EXPECT_EQ(objects[2], popped_object);
+  EXPECT_EQ(1, queue.size());
+  EXPECT_TRUE(queue.Pop(pop, &popped_object));
+  EXPECT_EQ(objects[1], popped_object);
+  EXPECT_TRUE(queue.Pop(pop, &popped_object));
+  EXPECT_EQ(objects[0], popped_object);
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_FALSE(queue.Pop(pop, &popped_object));
+}
+
+TEST_F(MarkingWorklistTest, PrefetchQueueFlush) {
+  MarkingWorklists holder;
+  MarkingWorklists::Local worklists(&holder);
+  ReadOnlyRoots roots(i_isolate()->heap());
+  worklists.Push(roots.undefined_value());
+  worklists.Push(roots.null_value());
+  worklists.Push(roots.true_value());
+  MarkingPrefetchQueue queue(MarkingPrefetchQueue::kMaxDistance + 1);
+  EXPECT_EQ(MarkingPrefetchQueue::kMaxDistance, queue.distance());
+  HeapObject popped_object;
+  EXPECT_TRUE(queue.Pop(
+      [&worklists](HeapObject* object) { return worklists.Pop(object); },
+      &popped_object));
+  EXPECT_EQ(roots.true_value(), popped_object);
+  EXPECT_EQ(2, queue.size());
+  EXPECT_TRUE(worklists.IsEmpty());
+  queue.Flush([&worklists](HeapObject object) { worklists.Push(object); });
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_TRUE(worklists.Pop(&popped_object));
+  EXPECT_EQ(roots.undefined_value(), popped_object);
+  EXPECT_TRUE(worklists.Pop(&popped_object));
+  EXPECT_EQ(roots.null_value(), popped_object);
+  EXPECT_TRUE(worklists.IsEmpty());
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -166,6 +166,55 @@ TEST(SlotSet, Remove) {
   SlotSet::Delete(set, SlotSet::kBucketsRegularPage);
 }
 
+TEST(SlotSet, FilterConcurrently) {
+  SlotSet* set = SlotSet::Allocate(SlotSet::kBucketsRegularPage);
+
+  for (int i = 0; i < Page::kPageSize; i += kTaggedSize) {
+    if (i % 7 == 0) {
+      set->Insert<AccessMode::ATOMIC>(i);
+    }
+  }
+
+  // Slots divisible by 5 simulate a concurrent store of a young object: they
+  // are stale on the first check and live on the re-check after clearing.
+  std::map<Address, int> checks;
+  size_t removed = set->FilterConcurrently(
+      kNullAddress, SlotSet::kBucketsRegularPage,
+      [&checks](MaybeObjectSlot slot) {
+        int check = checks[slot.address()]++;
+        if (slot.address() % 3 == 0) return KEEP_SLOT;
+        if (check > 0 && slot.address() % 5 == 0) return KEEP_SLOT;
+        return REMOVE_SLOT;
+      });
+
+  size_t expected_removed = 0;
+  for (int i = 0; i < Page::kPageSize; i += kTaggedSize) {
+    if (i % 7 == 0 && (i % 3 == 0 || i % 5 == 0)) {
+      EXPECT_TRUE(set->Lookup(i));
+    } else {
+      EXPECT_FALSE(set->Lookup(i));
+      if (i % 7 == 0) expected_removed++;
+    }
+  }
+  EXPECT_EQ(expected_removed, removed);
+
+  SlotSet::Delete(set, SlotSet::kBucketsRegularPage);
+}
+
+TEST(SlotSet, InsertAndPublish) {
+  SlotSet* set = SlotSet::Allocate(SlotSet::kBucketsRegularPage);
+
+  set->InsertAndPublish(0);
+  set->InsertAndPublish(0);
+  set->InsertAndPublish(Page::kPageSize - kTaggedSize);
+
+  for (int i = 0; i < Page::kPageSize; i += kTaggedSize) {
+    EXPECT_EQ(i == 0 || i == Page::kPageSize - kTaggedSize, set->Lookup(i));
+  }
+
+  SlotSet::Delete(set, SlotSet::kBucketsRegularPage);
+}
+
 TEST(PossiblyEmptyBuckets, ContainsAndInsert) {
   static const int kBuckets = 100;
   PossiblyEmptyBuckets possibly_empty_buckets;
@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+#
+# Copyright 2021 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Compares the young generation pauses of the Scavenger and of the minor
+mark-compactor on the YoungGeneration benchmark of test/js-perf-test.
+
+Usage: tools/young_gen_pauses.py out/x64.release/d8 [extra d8 flags]
+
+The benchmark runs once per collector with --trace-gc-nvp. The pause times of
+the young generation GCs are taken from the trace and printed as
+
+  YoungGeneration-<collector>-Pause<statistic>(ms): <value>
+
+so that they can be compared alongside the scores of the benchmark.
+"""
+
+
+# for py2/py3 compatibility
+from __future__ import print_function
+
+
+from argparse import ArgumentParser
+from gc_nvp_common import split_nvp
+from math import ceil
+import os
+import subprocess
+import sys
+
+
+BENCHMARK_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..',
+                             'test', 'js-perf-test', 'YoungGeneration')
+
+# Collector name, d8 flags, and the short GC name used by --trace-gc-nvp.
+COLLECTORS = [
+  ('Scavenger', [], 's'),
+  ('MinorMC', ['--minor-mc'], 'mmc'),
+]
+
+PERCENTILES = [50, 99]
+
+
+def percentile(sorted_values, percentile):
+  index = int(ceil((len(sorted_values) - 1) * percentile / 100.0))
+  return sorted_values[index]
+
+
+def collect_pauses(d8, flags, gc_name):
+  output = subprocess.check_output(
+      [os.path.abspath(d8), '--trace-gc-nvp'] + flags + ['run.js'],
+      cwd=BENCHMARK_DIR, universal_newlines=True)
+  pauses = []
+  for line in output.splitlines():
+    entry = split_nvp(line)
+    if entry.get('gc') == gc_name and 'pause' in entry:
+      pauses.append(entry['pause'])
+  return pauses
+
+
+def main():
+  parser = ArgumentParser(description=__doc__.split('\n\n')[0])
+  parser.add_argument('d8', help='path to the d8 binary')
+  # Everything else is passed to d8.
+  args, extra_flags = parser.parse_known_args()
+
+  for name, flags, gc_name in COLLECTORS:
+    pauses = sorted(collect_pauses(args.d8, flags + extra_flags, gc_name))
+    print('YoungGeneration-{0}-PauseCount: {1}'.format(name, len(pauses)))
+    if not pauses:
+      continue
+    for p in PERCENTILES:
+      print('YoungGeneration-{0}-PauseP{1}(ms): {2}'.format(
+          name, p, percentile(pauses, p)))
+    print('YoungGeneration-{0}-PauseMax(ms): {1}'.format(name, pauses[-1]))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())